@@ -0,0 +1,171 @@
+/**
+ * @file        : bench_dirty.c
+ * @brief       : Incremental (dirty-page) snapshots vs full memcpy snapshots at several write ratios.
+ *
+ * Details      :
+ * - tracked: dirty_track.c region; writes fault once per page per snapshot
+ *            interval, the snapshot copies only the dirty pages.
+ * - full:    plain read/write mapping; writes are free, the snapshot
+ *            memcpy()s the whole region.
+ * - For each write ratio, every round writes one word into that fraction
+ *   of the pages (random, distinct) and then takes a snapshot. Reported are
+ *   the write cost per page (the tracking tax), the snapshot time, and the
+ *   speedup of write + snapshot over the full copy. Both images are
+ *   compared at the end of each ratio, so a missed dirty page is caught.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ *
+ * Compile      : make bench_dirty
+ * Usage        : ./bench_dirty [-m MiB] [-r rounds]
+ * Example      : ./bench_dirty -m 256 -r 10
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE /* MAP_ANONYMOUS */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "dirty_track.h"
+#include "latency_hist.h"
+
+#define DEFAULT_MIB    64L
+#define DEFAULT_ROUNDS 5
+
+/* Fractions of the region written between two snapshots */
+static const double ratios[] = { 0.0001, 0.001, 0.01, 0.1, 0.5, 1.0 };
+
+static size_t page_size;
+static size_t *order;           /* random permutation of the page numbers */
+
+static uint64_t rng = 0x9E3779B97F4A7C15ull;
+static uint64_t xorshift(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    return rng;
+}
+
+/* Write one word into @p count distinct pages, starting at @p from in the permutation */
+static void write_pages(unsigned char *mem, size_t pages, size_t from, size_t count, uint64_t stamp)
+{
+    for (size_t i = 0; i < count; i++) {
+        size_t page = order[(from + i) % pages];
+        ((volatile uint64_t *)(mem + page * page_size))[page % 8] = stamp + i;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    long mib = DEFAULT_MIB;
+    int rounds = DEFAULT_ROUNDS;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "m:r:")) != -1) {
+        switch (opt) {
+        case 'm':
+            mib = atol(optarg);
+            break;
+        case 'r':
+            rounds = atoi(optarg);
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-m MiB] [-r rounds]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (mib < 1 || rounds < 1) {
+        fprintf(stderr, "size and rounds must be positive\n");
+        return 1;
+    }
+
+    page_size = (size_t)sysconf(_SC_PAGESIZE);
+    size_t bytes = (size_t)mib << 20;
+    size_t pages = bytes / page_size;
+
+    struct dirty_region tracked;
+    if (dirty_create(&tracked, bytes) == -1)
+        return 1;
+    unsigned char *plain = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+                                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    unsigned char *tracked_image = calloc(1, bytes);
+    unsigned char *plain_image = calloc(1, bytes);
+    order = malloc(pages * sizeof(*order));
+    if (plain == MAP_FAILED || tracked_image == NULL || plain_image == NULL || order == NULL) {
+        perror("allocation");
+        return 1;
+    }
+
+    for (size_t i = 0; i < pages; i++)
+        order[i] = i;
+    for (size_t i = pages - 1; i > 0; i--) {
+        size_t j = xorshift() % (i + 1);
+        size_t tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+
+    /* Populate both regions so every round measures steady state, not first touch */
+    write_pages(tracked.base, pages, 0, pages, 0);
+    write_pages(plain, pages, 0, pages, 0);
+    dirty_snapshot(&tracked, tracked_image);
+    memcpy(plain_image, plain, bytes);
+
+    printf("%.1f MiB region, %zu pages, %d rounds per ratio\n", bytes / 1048576.0, pages, rounds);
+    printf("%8s %8s | %12s %12s | %12s %12s | %8s\n", "ratio", "pages", "write tracked", "write plain",
+           "snap dirty", "snap full", "speedup");
+
+    uint64_t stamp = 1;
+    size_t from = 0;
+    for (size_t k = 0; k < sizeof(ratios) / sizeof(ratios[0]); k++) {
+        size_t count = (size_t)(ratios[k] * pages);
+        if (count == 0)
+            count = 1;
+        uint64_t wt = 0, wp = 0, st = 0, sp = 0;
+        size_t copied = 0;
+
+        for (int r = 0; r < rounds; r++) {
+            uint64_t t0 = mono_ns();
+            write_pages(tracked.base, pages, from, count, stamp);
+            uint64_t t1 = mono_ns();
+            copied += dirty_snapshot(&tracked, tracked_image);
+            uint64_t t2 = mono_ns();
+            write_pages(plain, pages, from, count, stamp);
+            uint64_t t3 = mono_ns();
+            memcpy(plain_image, plain, bytes);
+            uint64_t t4 = mono_ns();
+
+            wt += t1 - t0;
+            st += t2 - t1;
+            wp += t3 - t2;
+            sp += t4 - t3;
+            stamp += count;
+            from += count;
+        }
+
+        int same = memcmp(tracked_image, plain_image, bytes) == 0;
+        double n = (double)count * rounds;
+        printf("%8.4f %8zu | %9.0f ns %9.0f ns | %9.3f ms %9.3f ms | %7.1fx%s\n",
+               ratios[k], count, wt / n, wp / n, st / 1e6 / rounds, sp / 1e6 / rounds,
+               (double)(wp + sp) / (double)(wt + st),
+               same ? "" : "  IMAGE MISMATCH");
+        if (copied > (size_t)n)
+            printf("         (copied %zu pages: ran out of mappings, fell back to full copies)\n", copied);
+    }
+
+    printf("write faults taken: %zu\n", dirty_faults(&tracked));
+
+    free(order);
+    free(plain_image);
+    free(tracked_image);
+    munmap(plain, bytes);
+    dirty_destroy(&tracked);
+    return 0;
+}
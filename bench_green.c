@@ -0,0 +1,273 @@
+/**
+ * @file        : bench_green.c
+ * @brief       : Green threads (green.c) vs pthreads: switch cost, spawn cost and fairness.
+ *
+ * Details      :
+ * - switch:   two tasks hand the CPU back and forth. Green: green_yield()
+ *             ping-pong with no tick. pthreads: two threads pinned to one
+ *             CPU alternating on a pair of semaphores. Reported per switch.
+ * - spawn:    create, run and reap N empty tasks; ns per task.
+ * - fairness: N CPU-bound tasks that never yield run for -t seconds, the
+ *             green ones preempted by the SIGALRM tick every -s us, the
+ *             pthreads by the kernel. Reports total work, the min/max
+ *             per-task share and Jain's fairness index
+ *             (sum x)^2 / (N * sum x^2), 1.0 meaning perfectly even.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ *
+ * Compile      : make bench_green
+ * Usage        : ./bench_green [-n tasks] [-t seconds] [-s slice_us] [-k switches]
+ * Example      : ./bench_green -n 10000 -t 5 -s 100
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <semaphore.h>
+
+#include "green.h"
+#include "latency_hist.h"
+#include "cpu_affinity.h"
+
+#define DEFAULT_TASKS    1000
+#define DEFAULT_SECONDS  2.0
+#define DEFAULT_SLICE_US 100L
+#define DEFAULT_SWITCHES 1000000L
+
+/* Same stack size for both sides, so spawn costs are comparable */
+#define BENCH_STACK (64 * 1024)
+
+/* Work units between deadline checks in the fairness loop */
+#define CHECK_EVERY 1024
+
+static long switches;
+static uint64_t deadline;
+static uint64_t *work;          /* per-task work units done */
+
+/* ---------- green ---------- */
+
+static void green_pingpong(void *arg)
+{
+    (void)arg;
+    for (long i = 0; i < switches; i++)
+        green_yield();
+}
+
+static void green_empty(void *arg)
+{
+    (void)arg;
+}
+
+/* CPU-bound: never yields, only the tick takes the CPU away */
+static void green_spin(void *arg)
+{
+    uint64_t *mine = arg;
+    volatile uint64_t sink = 0;
+    for (uint64_t n = 1;; n++) {
+        sink += n * n;
+        if (n % CHECK_EVERY == 0) {
+            *mine = n;
+            if (mono_ns() >= deadline)
+                break;
+        }
+    }
+}
+
+/* ---------- pthreads ---------- */
+
+static sem_t ping, pong;
+
+static void *thread_ping(void *arg)
+{
+    (void)arg;
+    pin_thread_to_cpu(0);
+    for (long i = 0; i < switches; i++) {
+        sem_post(&pong);
+        sem_wait(&ping);
+    }
+    return NULL;
+}
+
+static void *thread_pong(void *arg)
+{
+    (void)arg;
+    pin_thread_to_cpu(0);
+    for (long i = 0; i < switches; i++) {
+        sem_wait(&pong);
+        sem_post(&ping);
+    }
+    return NULL;
+}
+
+static void *thread_empty(void *arg)
+{
+    return arg;
+}
+
+static pthread_barrier_t start_line;
+
+static void *thread_spin(void *arg)
+{
+    pthread_barrier_wait(&start_line);
+    green_spin(arg);
+    return NULL;
+}
+
+/* ---------- reporting ---------- */
+
+static void report_fairness(const char *name, int n)
+{
+    double sum = 0, sq = 0;
+    uint64_t lo = UINT64_MAX, hi = 0;
+    for (int i = 0; i < n; i++) {
+        double x = (double)work[i];
+        sum += x;
+        sq += x * x;
+        if (work[i] < lo)
+            lo = work[i];
+        if (work[i] > hi)
+            hi = work[i];
+    }
+    double mean = sum / n;
+    printf("%-8s fairness: %d tasks, %.3g work units, min %.2fx / max %.2fx of mean, Jain %.4f\n",
+           name, n, sum, mean > 0 ? lo / mean : 0.0, mean > 0 ? hi / mean : 0.0,
+           sq > 0 ? sum * sum / (n * sq) : 0.0);
+}
+
+int main(int argc, char *argv[])
+{
+    int ntasks = DEFAULT_TASKS;
+    double seconds = DEFAULT_SECONDS;
+    long slice_us = DEFAULT_SLICE_US;
+    int opt;
+    switches = DEFAULT_SWITCHES;
+
+    while ((opt = getopt(argc, argv, "n:t:s:k:")) != -1) {
+        switch (opt) {
+        case 'n':
+            ntasks = atoi(optarg);
+            break;
+        case 't':
+            seconds = atof(optarg);
+            break;
+        case 's':
+            slice_us = atol(optarg);
+            break;
+        case 'k':
+            switches = atol(optarg);
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-n tasks] [-t seconds] [-s slice_us] [-k switches]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+    if (ntasks < 2 || slice_us < 1 || switches < 1) {
+        fprintf(stderr, "need at least 2 tasks, a positive slice and switch count\n");
+        return 1;
+    }
+
+    work = calloc((size_t)ntasks, sizeof(*work));
+    pthread_t *threads = calloc((size_t)ntasks, sizeof(*threads));
+    if (work == NULL || threads == NULL) {
+        perror("calloc");
+        return 1;
+    }
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, BENCH_STACK);
+
+    /* switch cost, cooperative green (no tick) */
+    if (green_init(ntasks, BENCH_STACK, 0) == -1)
+        return 1;
+    uint64_t t0 = mono_ns();
+    green_spawn(green_pingpong, NULL);
+    green_spawn(green_pingpong, NULL);
+    green_run();
+    double green_switch = (double)(mono_ns() - t0) / (2.0 * switches);
+
+    /* spawn cost, green (stacks are already pooled after the first round) */
+    t0 = mono_ns();
+    for (int i = 0; i < ntasks; i++)
+        green_spawn(green_empty, NULL);
+    green_run();
+    double green_spawn_cold = (double)(mono_ns() - t0) / ntasks;
+    t0 = mono_ns();
+    for (int i = 0; i < ntasks; i++)
+        green_spawn(green_empty, NULL);
+    green_run();
+    double green_spawn_warm = (double)(mono_ns() - t0) / ntasks;
+    green_shutdown();
+
+    /* switch cost, pthreads */
+    sem_init(&ping, 0, 0);
+    sem_init(&pong, 0, 0);
+    t0 = mono_ns();
+    pthread_create(&threads[0], &attr, thread_ping, NULL);
+    pthread_create(&threads[1], &attr, thread_pong, NULL);
+    pthread_join(threads[0], NULL);
+    pthread_join(threads[1], NULL);
+    double thread_switch = (double)(mono_ns() - t0) / (2.0 * switches);
+
+    /* spawn cost, pthreads */
+    int created = 0;
+    t0 = mono_ns();
+    for (int i = 0; i < ntasks; i++)
+        if (pthread_create(&threads[i], &attr, thread_empty, NULL) == 0)
+            created++;
+        else
+            break;
+    for (int i = 0; i < created; i++)
+        pthread_join(threads[i], NULL);
+    double thread_spawn = created > 0 ? (double)(mono_ns() - t0) / created : 0.0;
+
+    printf("switch:  green %.0f ns, pthread %.0f ns per switch (%ld round trips)\n",
+           green_switch, thread_switch, switches);
+    printf("spawn:   green %.0f ns (%.0f ns with pooled stacks), pthread %.0f ns per task (%d tasks)\n",
+           green_spawn_cold, green_spawn_warm, thread_spawn, created);
+
+    /* fairness, green: preempted by the SIGALRM tick */
+    if (green_init(ntasks, BENCH_STACK, slice_us) == -1)
+        return 1;
+    for (int i = 0; i < ntasks; i++)
+        green_spawn(green_spin, &work[i]);
+    deadline = mono_ns() + (uint64_t)(seconds * 1e9);
+    green_run();
+    struct green_stats gs;
+    green_get_stats(&gs);
+    green_shutdown();
+    report_fairness("green", ntasks);
+    printf("         %llu preemptions (%.1f slices per task), %llu stacks mapped, %ld us slice\n",
+           (unsigned long long)gs.preemptions, (double)gs.preemptions / ntasks,
+           (unsigned long long)gs.stacks, slice_us);
+
+    /* fairness, pthreads: preempted by the kernel */
+    memset(work, 0, (size_t)ntasks * sizeof(*work));
+    pthread_barrier_init(&start_line, NULL, (unsigned)ntasks + 1);
+    created = 0;
+    for (int i = 0; i < ntasks; i++) {
+        if (pthread_create(&threads[i], &attr, thread_spin, &work[i]) != 0) {
+            perror("pthread_create");
+            return 1; /* the barrier would wait forever for the missing threads */
+        }
+        created++;
+    }
+    deadline = mono_ns() + (uint64_t)(seconds * 1e9);
+    pthread_barrier_wait(&start_line);
+    for (int i = 0; i < created; i++)
+        pthread_join(threads[i], NULL);
+    report_fairness("pthread", created);
+
+    pthread_barrier_destroy(&start_line);
+    pthread_attr_destroy(&attr);
+    free(threads);
+    free(work);
+    return 0;
+}
@@ -0,0 +1,537 @@
+/**
+ * @file        : bench_ipc.c
+ * @brief       : Runs the Signal Tennis rally over several IPC transports and compares them.
+ *
+ * Details      :
+ * - Same protocol as bench_tennis: two processes hit a volley counter back
+ *   and forth, the server times every round trip, and a stop value ends the
+ *   game. Only the transport that carries the counter changes:
+ *     sigqueue   SIGUSR1 + sival_int, received with sigwaitinfo()
+ *     signalfd   SIGUSR1 + sival_int, received by read() on a signalfd
+ *     eventfd    one eventfd per direction, the counter is the eventfd value
+ *     pipe       one pipe per direction, 4-byte messages
+ *     futex      shared-memory mailbox word, FUTEX_WAIT/FUTEX_WAKE
+ *     dgram      AF_UNIX SOCK_DGRAM socketpair, 4-byte datagrams
+ *     busypoll   shared-memory mailbox word, spun on (yields after a while
+ *                so a single-CPU machine still makes progress)
+ * - Results go to stdout as CSV (one row per transport) so runs can be
+ *   collected and compared; progress goes to stderr.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Extra Credit – Signal Tennis
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ *
+ * Compile      : make bench_ipc
+ * Usage        : ./bench_ipc [-n volleys] [-t transport[,transport...]] [-p]
+ * Example      : ./bench_ipc -n 200000 -t futex,eventfd,sigqueue -p > ipc.csv
+ *
+ * Algorithm
+ *  1. Block SIGUSR1 once so the signal transports never miss a ball.
+ *  2. For each selected transport: create its channels, fork a returner,
+ *     optionally pin both players to different CPUs.
+ *  3. The server sends odd volleys and waits for the even reply, recording
+ *     each round trip; the returner answers v with v + 1.
+ *  4. Send the stop value, reap the returner and print one CSV row.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE /* MAP_ANONYMOUS, syscall() */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <errno.h>
+#include <signal.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/signalfd.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <linux/futex.h>
+
+#include "latency_hist.h"
+#include "cpu_affinity.h"
+
+#define DEFAULT_VOLLEYS 100000L
+
+/* Sent by the server after the last round trip */
+#define STOP_VALUE UINT32_MAX
+
+/* Spins before busypoll gives the CPU away */
+#define SPIN_LIMIT 4096
+
+#if defined(__x86_64__) || defined(__i386__)
+#define cpu_relax() __builtin_ia32_pause()
+#else
+#define cpu_relax() ((void)0)
+#endif
+
+/* One mailbox per direction, each on its own cache line */
+struct mailbox {
+    _Alignas(64) _Atomic uint32_t value;
+};
+
+/* Per-process view of a transport; side 0 serves, side 1 returns */
+struct ipc_ctx {
+    int side;
+    pid_t peer;
+    int rd[2];              /* fd each side receives on */
+    int wr[2];              /* fd each side sends to its peer on */
+    size_t width;           /* bytes per fd message (4, or 8 for eventfd) */
+    struct mailbox *box;    /* box[s] is what side s receives */
+    uint32_t last;          /* last mailbox value seen by this side */
+};
+
+struct transport {
+    const char *name;
+    int (*setup)(struct ipc_ctx *ctx);    /* before fork */
+    int (*attach)(struct ipc_ctx *ctx);   /* after fork, in each player (may be NULL) */
+    int (*send)(struct ipc_ctx *ctx, uint32_t value);
+    int (*recv)(struct ipc_ctx *ctx, uint32_t *value);
+};
+
+/* ---------- signals ---------- */
+
+static int sig_setup(struct ipc_ctx *ctx)
+{
+    (void)ctx;
+    return 0;
+}
+
+static int sig_send(struct ipc_ctx *ctx, uint32_t value)
+{
+    union sigval sv;
+    sv.sival_int = (int)value;
+    while (sigqueue(ctx->peer, SIGUSR1, sv) == -1) {
+        if (errno != EAGAIN) {
+            perror("sigqueue");
+            return -1;
+        }
+        sched_yield();
+    }
+    return 0;
+}
+
+static int sigwait_recv(struct ipc_ctx *ctx, uint32_t *value)
+{
+    (void)ctx;
+    sigset_t set;
+    siginfo_t info;
+    sigemptyset(&set);
+    sigaddset(&set, SIGUSR1);
+
+    while (sigwaitinfo(&set, &info) == -1) {
+        if (errno != EINTR) {
+            perror("sigwaitinfo");
+            return -1;
+        }
+    }
+    *value = (uint32_t)info.si_value.sival_int;
+    return 0;
+}
+
+static int signalfd_attach(struct ipc_ctx *ctx)
+{
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, SIGUSR1);
+
+    ctx->rd[ctx->side] = signalfd(-1, &set, SFD_CLOEXEC);
+    if (ctx->rd[ctx->side] == -1) {
+        perror("signalfd");
+        return -1;
+    }
+    return 0;
+}
+
+static int signalfd_recv(struct ipc_ctx *ctx, uint32_t *value)
+{
+    struct signalfd_siginfo ssi;
+    ssize_t got;
+    while ((got = read(ctx->rd[ctx->side], &ssi, sizeof(ssi))) == -1 && errno == EINTR)
+        ;
+    if (got != (ssize_t)sizeof(ssi)) {
+        perror("read signalfd");
+        return -1;
+    }
+    *value = (uint32_t)ssi.ssi_int;
+    return 0;
+}
+
+/* ---------- file descriptors: eventfd, pipe, dgram ---------- */
+
+static int efd_setup(struct ipc_ctx *ctx)
+{
+    for (int s = 0; s < 2; s++) {
+        int fd = eventfd(0, EFD_CLOEXEC);
+        if (fd == -1) {
+            perror("eventfd");
+            return -1;
+        }
+        ctx->rd[s] = fd;        /* side s reads its own eventfd */
+        ctx->wr[1 - s] = fd;    /* the peer writes into it */
+    }
+    ctx->width = sizeof(uint64_t);
+    return 0;
+}
+
+static int pipe_setup(struct ipc_ctx *ctx)
+{
+    for (int s = 0; s < 2; s++) {
+        int p[2];
+        if (pipe(p) == -1) {
+            perror("pipe");
+            return -1;
+        }
+        ctx->rd[s] = p[0];
+        ctx->wr[1 - s] = p[1];
+    }
+    ctx->width = sizeof(uint32_t);
+    return 0;
+}
+
+static int dgram_setup(struct ipc_ctx *ctx)
+{
+    int sv[2];
+    if (socketpair(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0, sv) == -1) {
+        perror("socketpair");
+        return -1;
+    }
+    /* Each side sends and receives on its own end of the pair */
+    for (int s = 0; s < 2; s++)
+        ctx->rd[s] = ctx->wr[s] = sv[s];
+    ctx->width = sizeof(uint32_t);
+    return 0;
+}
+
+static int fd_send(struct ipc_ctx *ctx, uint32_t value)
+{
+    uint64_t wide = value; /* eventfd takes 8 bytes; the rest take the low 4 */
+    uint32_t narrow = value;
+    const void *buf = ctx->width == sizeof(wide) ? (const void *)&wide : (const void *)&narrow;
+
+    ssize_t put;
+    while ((put = write(ctx->wr[ctx->side], buf, ctx->width)) == -1 && errno == EINTR)
+        ;
+    if (put != (ssize_t)ctx->width) {
+        perror("write");
+        return -1;
+    }
+    return 0;
+}
+
+static int fd_recv(struct ipc_ctx *ctx, uint32_t *value)
+{
+    uint64_t wide = 0;
+    uint32_t narrow = 0;
+    void *buf = ctx->width == sizeof(wide) ? (void *)&wide : (void *)&narrow;
+
+    ssize_t got;
+    while ((got = read(ctx->rd[ctx->side], buf, ctx->width)) == -1 && errno == EINTR)
+        ;
+    if (got != (ssize_t)ctx->width) {
+        perror("read");
+        return -1;
+    }
+    *value = ctx->width == sizeof(wide) ? (uint32_t)wide : narrow;
+    return 0;
+}
+
+/* ---------- shared memory: futex, busypoll ---------- */
+
+static int shm_setup(struct ipc_ctx *ctx)
+{
+    ctx->box = mmap(NULL, 2 * sizeof(struct mailbox), PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (ctx->box == MAP_FAILED) {
+        perror("mmap");
+        ctx->box = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+static long futex(_Atomic uint32_t *word, int op, uint32_t val)
+{
+    /* Not FUTEX_PRIVATE_FLAG: the word is shared between two processes */
+    return syscall(SYS_futex, (uint32_t *)word, op, val, NULL, NULL, 0);
+}
+
+static int futex_send(struct ipc_ctx *ctx, uint32_t value)
+{
+    struct mailbox *peer = &ctx->box[1 - ctx->side];
+    atomic_store_explicit(&peer->value, value, memory_order_release);
+    if (futex(&peer->value, FUTEX_WAKE, 1) == -1) {
+        perror("futex wake");
+        return -1;
+    }
+    return 0;
+}
+
+static int futex_recv(struct ipc_ctx *ctx, uint32_t *value)
+{
+    struct mailbox *mine = &ctx->box[ctx->side];
+    uint32_t v;
+
+    /* Sleep only while the word still holds the old value; EAGAIN means it moved */
+    while ((v = atomic_load_explicit(&mine->value, memory_order_acquire)) == ctx->last) {
+        if (futex(&mine->value, FUTEX_WAIT, ctx->last) == -1 && errno != EAGAIN && errno != EINTR) {
+            perror("futex wait");
+            return -1;
+        }
+    }
+    ctx->last = v;
+    *value = v;
+    return 0;
+}
+
+static int poll_send(struct ipc_ctx *ctx, uint32_t value)
+{
+    atomic_store_explicit(&ctx->box[1 - ctx->side].value, value, memory_order_release);
+    return 0;
+}
+
+static int poll_recv(struct ipc_ctx *ctx, uint32_t *value)
+{
+    struct mailbox *mine = &ctx->box[ctx->side];
+    uint32_t v;
+    unsigned spins = 0;
+
+    while ((v = atomic_load_explicit(&mine->value, memory_order_acquire)) == ctx->last) {
+        if (++spins < SPIN_LIMIT) {
+            cpu_relax();
+        } else {
+            sched_yield(); /* the peer may need this CPU to answer */
+            spins = 0;
+        }
+    }
+    ctx->last = v;
+    *value = v;
+    return 0;
+}
+
+static const struct transport transports[] = {
+    { "sigqueue", sig_setup,   NULL,            sig_send,   sigwait_recv  },
+    { "signalfd", sig_setup,   signalfd_attach, sig_send,   signalfd_recv },
+    { "eventfd",  efd_setup,   NULL,            fd_send,    fd_recv       },
+    { "pipe",     pipe_setup,  NULL,            fd_send,    fd_recv       },
+    { "futex",    shm_setup,   NULL,            futex_send, futex_recv    },
+    { "dgram",    dgram_setup, NULL,            fd_send,    fd_recv       },
+    { "busypoll", shm_setup,   NULL,            poll_send,  poll_recv     },
+};
+#define TRANSPORT_COUNT (sizeof(transports) / sizeof(transports[0]))
+
+/* Close every fd and unmap the mailboxes of a finished transport */
+static void ctx_release(struct ipc_ctx *ctx)
+{
+    int closed[4];
+    int n = 0;
+
+    for (int s = 0; s < 2; s++) {
+        int fds[2] = { ctx->rd[s], ctx->wr[s] };
+        for (int k = 0; k < 2; k++) {
+            int fd = fds[k], seen = 0;
+            for (int c = 0; c < n; c++)
+                seen |= closed[c] == fd;
+            if (fd >= 0 && !seen) {
+                close(fd);
+                closed[n++] = fd;
+            }
+        }
+    }
+    if (ctx->box != NULL)
+        munmap(ctx->box, 2 * sizeof(struct mailbox));
+}
+
+/* Returner: answer every volley v with v + 1 until the stop value arrives */
+static int play_return(const struct transport *t, struct ipc_ctx *ctx)
+{
+    for (;;) {
+        uint32_t v;
+        if (t->recv(ctx, &v) == -1)
+            return -1;
+        if (v == STOP_VALUE)
+            return 0;
+        if (t->send(ctx, v + 1) == -1)
+            return -1;
+    }
+}
+
+/* Server: odd volleys out, even volleys back, one RTT sample per pair */
+static long play_serve(const struct transport *t, struct ipc_ctx *ctx, long volleys,
+                       struct latency_hist *rtt)
+{
+    long hits = 0;
+
+    for (uint32_t v = 1; hits + 2 <= volleys; v += 2) {
+        uint64_t sent_at = mono_ns();
+        uint32_t back;
+        if (t->send(ctx, v) == -1 || t->recv(ctx, &back) == -1)
+            return -1;
+        hist_record(rtt, mono_ns() - sent_at);
+        if (back != v + 1) {
+            fprintf(stderr, "[%s] expected volley %u, got %u\n", t->name, v + 1, back);
+            return -1;
+        }
+        hits += 2;
+    }
+    if (t->send(ctx, STOP_VALUE) == -1)
+        return -1;
+    return hits;
+}
+
+/* Run one transport and print its CSV row; returns 0 on success */
+static int run_transport(const struct transport *t, long volleys, int pin)
+{
+    struct ipc_ctx ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.rd[0] = ctx.rd[1] = ctx.wr[0] = ctx.wr[1] = -1;
+
+    if (t->setup(&ctx) == -1) {
+        ctx_release(&ctx);
+        return -1;
+    }
+
+    pid_t child = fork();
+    if (child == -1) {
+        perror("fork");
+        ctx_release(&ctx);
+        return -1;
+    }
+    if (child == 0) {
+        ctx.side = 1;
+        ctx.peer = getppid();
+        if (pin)
+            pin_thread_to_cpu(1);
+        if (t->attach != NULL && t->attach(&ctx) == -1)
+            _exit(1);
+        _exit(play_return(t, &ctx) == -1 ? 1 : 0);
+    }
+
+    ctx.side = 0;
+    ctx.peer = child;
+    if (pin)
+        pin_thread_to_cpu(0);
+
+    static struct latency_hist rtt;
+    hist_init(&rtt);
+
+    fprintf(stderr, "[BENCH] %-8s rallying %ld volleys with PID %d...\n", t->name, volleys, child);
+
+    long hits = -1;
+    uint64_t start = mono_ns();
+    if (t->attach == NULL || t->attach(&ctx) == 0)
+        hits = play_serve(t, &ctx, volleys, &rtt);
+    uint64_t elapsed = mono_ns() - start;
+
+    if (hits < 0)
+        kill(child, SIGKILL);
+
+    int status = 0;
+    waitpid(child, &status, 0);
+    ctx_release(&ctx);
+
+    if (hits < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        fprintf(stderr, "[BENCH] %s: rally aborted\n", t->name);
+        return -1;
+    }
+
+    double secs = elapsed / 1e9;
+    printf("%s,%ld,%.6f,%.0f,%llu,%llu,%llu,%llu,%llu\n",
+           t->name, hits, secs, hits / secs,
+           (unsigned long long)hist_percentile(&rtt, 50.0),
+           (unsigned long long)hist_percentile(&rtt, 90.0),
+           (unsigned long long)hist_percentile(&rtt, 99.0),
+           (unsigned long long)hist_percentile(&rtt, 99.9),
+           (unsigned long long)rtt.max);
+    fflush(stdout);
+    return 0;
+}
+
+/* Is @p name in the comma-separated @p list (NULL selects everything)? */
+static int selected(const char *list, const char *name)
+{
+    if (list == NULL)
+        return 1;
+    size_t len = strlen(name);
+    for (const char *p = list; *p != '\0';) {
+        const char *end = strchr(p, ',');
+        size_t n = end ? (size_t)(end - p) : strlen(p);
+        if (n == len && strncmp(p, name, n) == 0)
+            return 1;
+        p += n + (end != NULL);
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    long volleys = DEFAULT_VOLLEYS;
+    const char *only = NULL;
+    int pin = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:t:p")) != -1) {
+        switch (opt) {
+        case 'n':
+            volleys = atol(optarg);
+            break;
+        case 't':
+            only = optarg;
+            break;
+        case 'p':
+            pin = 1;
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-n volleys] [-t transport[,transport...]] [-p]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (volleys < 2 || volleys >= (long)STOP_VALUE) {
+        fprintf(stderr, "volleys must be between 2 and %u\n", STOP_VALUE - 1);
+        return 1;
+    }
+
+    /* Reject unknown names up front rather than silently skipping them */
+    if (only != NULL) {
+        for (const char *p = only; *p != '\0';) {
+            const char *end = strchr(p, ',');
+            size_t n = end ? (size_t)(end - p) : strlen(p);
+            int known = 0;
+            for (size_t i = 0; i < TRANSPORT_COUNT; i++)
+                known |= strlen(transports[i].name) == n && strncmp(p, transports[i].name, n) == 0;
+            if (!known) {
+                fprintf(stderr, "Unknown transport '%.*s'\n", (int)n, p);
+                return 1;
+            }
+            p += n + (end != NULL);
+        }
+    }
+
+    /* The signal transports need SIGUSR1 blocked before the returner is forked */
+    sigset_t block;
+    sigemptyset(&block);
+    sigaddset(&block, SIGUSR1);
+    if (sigprocmask(SIG_BLOCK, &block, NULL) == -1) {
+        perror("sigprocmask");
+        return 1;
+    }
+
+    if (pin && online_cpus() < 2)
+        fprintf(stderr, "[BENCH] only one CPU online; -p pins both players to it\n");
+
+    printf("transport,volleys,seconds,msgs_per_s,rtt_p50_ns,rtt_p90_ns,rtt_p99_ns,rtt_p999_ns,rtt_max_ns\n");
+    fflush(stdout);
+
+    int failed = 0;
+    for (size_t i = 0; i < TRANSPORT_COUNT; i++)
+        if (selected(only, transports[i].name) && run_transport(&transports[i], volleys, pin) == -1)
+            failed = 1;
+    return failed;
+}
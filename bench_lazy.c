@@ -0,0 +1,145 @@
+/**
+ * @file        : bench_lazy.c
+ * @brief       : Cost per page of SIGSEGV demand paging vs calloc and MAP_NORESERVE first-touch.
+ *
+ * Details      :
+ * - lazy:      lazy_mem region; each first touch goes through the SIGSEGV
+ *              handler and an mprotect() before the kernel's own page fault.
+ * - calloc:    the whole array allocated up front, then touched (glibc serves
+ *              large blocks from a fresh mmap, so zeroing is paid on touch).
+ * - noreserve: MAP_NORESERVE read/write mapping, populated by first touch
+ *              (kernel page fault only, no signal).
+ * - Each strategy is run dense (every page) and sparse (1 page in -s),
+ *   reporting ns per touched page and resident memory growth.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ *
+ * Compile      : make bench_lazy
+ * Usage        : ./bench_lazy [-p pages] [-s stride]
+ * Example      : ./bench_lazy -p 65536 -s 64
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE /* MAP_ANONYMOUS, MAP_NORESERVE */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "lazy_mem.h"
+#include "latency_hist.h"
+
+#define DEFAULT_PAGES  32768L
+#define DEFAULT_STRIDE 64L
+
+enum strategy { LAZY, CALLOC, NORESERVE };
+static const char *names[] = { "lazy", "calloc", "noreserve" };
+
+static long page_size;
+
+static long rss_kib(void)
+{
+    long pages = 0, resident = 0;
+    FILE *fp = fopen("/proc/self/statm", "r");
+    if (fp == NULL)
+        return -1;
+    if (fscanf(fp, "%ld %ld", &pages, &resident) != 2)
+        resident = -1;
+    fclose(fp);
+    return resident < 0 ? -1 : resident * (page_size / 1024);
+}
+
+/* Allocate, touch every stride-th page, free; prints one result line */
+static void run(enum strategy s, long pages, long stride)
+{
+    size_t bytes = (size_t)pages * (size_t)page_size;
+    struct lazy_region region;
+    unsigned char *mem = NULL;
+    long rss0 = rss_kib();
+
+    uint64_t t0 = mono_ns();
+    switch (s) {
+    case LAZY:
+        if (lazy_reserve(&region, bytes, 0) == 0)
+            mem = region.base;
+        break;
+    case CALLOC:
+        mem = calloc((size_t)pages, (size_t)page_size);
+        break;
+    case NORESERVE:
+        mem = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (mem == MAP_FAILED)
+            mem = NULL;
+        break;
+    }
+    if (mem == NULL) {
+        fprintf(stderr, "%s: allocation failed\n", names[s]);
+        return;
+    }
+    uint64_t t1 = mono_ns();
+
+    long touched = 0;
+    for (long p = 0; p < pages; p += stride) {
+        mem[(size_t)p * (size_t)page_size] = 1;
+        touched++;
+    }
+    uint64_t t2 = mono_ns();
+    long grown = rss_kib() - rss0;
+
+    printf("%-10s stride %-4ld %8ld pages  alloc %9.3f ms  touch %8.0f ns/page  total %8.0f ns/page  rss +%ld KiB\n",
+           names[s], stride, touched, (t1 - t0) / 1e6,
+           (double)(t2 - t1) / touched, (double)(t2 - t0) / touched, grown);
+
+    switch (s) {
+    case LAZY:
+        lazy_release(&region);
+        break;
+    case CALLOC:
+        free(mem);
+        break;
+    case NORESERVE:
+        munmap(mem, bytes);
+        break;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    long pages = DEFAULT_PAGES;
+    long stride = DEFAULT_STRIDE;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "p:s:")) != -1) {
+        switch (opt) {
+        case 'p':
+            pages = atol(optarg);
+            break;
+        case 's':
+            stride = atol(optarg);
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-p pages] [-s stride]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (pages < 1 || stride < 1) {
+        fprintf(stderr, "pages and stride must be positive\n");
+        return 1;
+    }
+
+    page_size = sysconf(_SC_PAGESIZE);
+    printf("%ld pages of %ld bytes (%.1f MiB)\n", pages, page_size,
+           pages * (double)page_size / (1 << 20));
+
+    long strides[2] = { 1, stride };
+    for (int i = 0; i < 2; i++)
+        for (int s = LAZY; s <= NORESERVE; s++)
+            run((enum strategy)s, pages, strides[i]);
+    return 0;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file        : bench_profiler.c
+ * @brief       : Measures the overhead of the SIGPROF sampling profiler and dumps folded stacks.
+ *
+ * Details      :
+ * - Runs a fixed CPU workload (a recursive Fibonacci and a hashing loop)
+ *   for a set time without the profiler, then again with it sampling at
+ *   -f Hz, and reports the throughput lost as the overhead percentage.
+ * - The profiled run's folded stacks are written to -o (default
+ *   profile.folded); feed them to flamegraph.pl to draw a flame graph.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ *
+ * Compile      : make bench_profiler
+ * Usage        : ./bench_profiler [-f hz] [-t seconds] [-o folded_file]
+ * Example      : ./bench_profiler -f 1000 -t 3 -o profile.folded
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include "prof_sampler.h"
+#include "latency_hist.h"
+
+/* Workload pieces: noinline keeps them as separate frames, and external
+ * linkage plus -rdynamic lets dladdr() name them in the profile */
+__attribute__((noinline)) uint64_t fib(unsigned n)
+{
+    return n < 2 ? n : fib(n - 1) + fib(n - 2);
+}
+
+__attribute__((noinline)) uint64_t hash_block(uint64_t seed)
+{
+    uint64_t h = seed ^ 1469598103934665603ull;
+    for (int i = 0; i < 20000; i++)
+        h = (h ^ (uint64_t)i) * 1099511628211ull;
+    return h;
+}
+
+__attribute__((noinline)) uint64_t work_unit(uint64_t seed)
+{
+    return fib(20) + hash_block(seed);
+}
+
+/* Run work units for @p seconds; returns units completed */
+static uint64_t run_for(double seconds, volatile uint64_t *sink)
+{
+    uint64_t end = mono_ns() + (uint64_t)(seconds * 1e9);
+    uint64_t units = 0;
+    while (mono_ns() < end) {
+        *sink += work_unit(units);
+        units++;
+    }
+    return units;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned hz = 1000;
+    double seconds = 2.0;
+    const char *out = "profile.folded";
+    int opt;
+
+    while ((opt = getopt(argc, argv, "f:t:o:")) != -1) {
+        switch (opt) {
+        case 'f':
+            hz = (unsigned)atoi(optarg);
+            break;
+        case 't':
+            seconds = atof(optarg);
+            break;
+        case 'o':
+            out = optarg;
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-f hz] [-t seconds] [-o folded_file]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (hz == 0 || seconds <= 0) {
+        fprintf(stderr, "frequency and duration must be positive\n");
+        return 1;
+    }
+
+    volatile uint64_t sink = 0;
+    run_for(0.2, &sink); /* warm up caches and CPU frequency */
+
+    uint64_t base = run_for(seconds, &sink);
+
+    if (prof_start(hz, (size_t)(hz * seconds * 2) + 1024) == -1)
+        return 1;
+    uint64_t profiled = run_for(seconds, &sink);
+    long samples = prof_stop(out);
+
+    double overhead = 100.0 * (1.0 - (double)profiled / (double)base);
+    printf("baseline : %llu units in %.1f s\n", (unsigned long long)base, seconds);
+    printf("profiled : %llu units in %.1f s at %u Hz, %ld samples\n",
+           (unsigned long long)profiled, seconds, hz, samples);
+    printf("overhead : %.2f%%\n", overhead);
+    printf("folded stacks written to %s\n", out);
+    return 0;
+}
@@ -0,0 +1,294 @@
+/**
+ * @file        : bench_route.c
+ * @brief       : Process-directed vs thread-directed (sig_router.c) delivery to sharded workers.
+ *
+ * Details      :
+ * - The receiver runs one worker per shard, each pinned to its own CPU and
+ *   registered in a routing table. Channel c belongs to shard c % workers;
+ *   handling a message updates that shard's 64 KiB state table.
+ * - A forked sender offers the same open-loop load (-R msg/s) twice:
+ *     process: sigqueue() to the receiver; the kernel picks any thread.
+ *     thread:  router_send(); the message is queued on the owner thread.
+ * - Each message carries its send time (CLOCK_MONOTONIC ns) in sival_ptr,
+ *   so wakeup latency is measured end to end per message.
+ * - Reported per mode: achieved rate, messages handled off-shard (state
+ *   owned by another core), latency percentiles, and per-message cache
+ *   misses and context switches of the workers from perf_event_open()
+ *   ("n/a" where the counters are not available, e.g. in a VM).
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ *
+ * Compile      : make bench_route
+ * Usage        : ./bench_route [-w workers] [-n messages] [-R rate] [-k channels]
+ * Example      : ./bench_route -w 4 -n 200000 -R 50000 -k 16
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE /* syscall() */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sys/wait.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "sig_router.h"
+#include "rt_channel.h"
+#include "latency_hist.h"
+#include "cpu_affinity.h"
+
+#define DEFAULT_MESSAGES 200000L
+#define DEFAULT_RATE     20000.0
+
+/* Per-shard state each message updates (64 KiB) and how much of it */
+#define STATE_WORDS   8192
+#define TOUCH_PER_MSG 16
+
+/* How often idle workers re-check for shutdown */
+#define WORKER_TIMEOUT_NS 50000000L
+
+/* How long to wait for the last messages after the sender is done */
+#define DRAIN_TIMEOUT_NS 2000000000ULL
+
+enum mode { PROCESS, THREAD };
+static const char *mode_names[] = { "process", "thread" };
+
+struct worker
+{
+    _Alignas(64) _Atomic uint64_t received;
+    uint64_t off_shard;
+    uint64_t cache_misses;  /* UINT64_MAX when not available */
+    uint64_t switches;
+    struct latency_hist hist;
+    pthread_t thread;
+    int index;
+};
+
+static struct worker workers[ROUTE_MAX_SHARDS];
+static uint64_t shard_state[ROUTE_MAX_SHARDS][STATE_WORDS];
+static int nworkers;
+static sigset_t channel_mask;
+static _Atomic int stop_workers;
+static struct sig_router router;
+
+static int perf_open(uint32_t type, uint64_t config)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    /* Count this thread (pid 0) on whatever CPU it runs on */
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static uint64_t perf_read(int fd)
+{
+    uint64_t v;
+    if (fd < 0 || read(fd, &v, sizeof(v)) != (ssize_t)sizeof(v))
+        return UINT64_MAX;
+    return v;
+}
+
+static void *worker_main(void *arg)
+{
+    struct worker *w = arg;
+    router_register(&router, w->index, w->index);
+
+    int misses_fd = perf_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    int switch_fd = perf_open(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES);
+    if (misses_fd >= 0)
+        ioctl(misses_fd, PERF_EVENT_IOC_ENABLE, 0);
+    if (switch_fd >= 0)
+        ioctl(switch_fd, PERF_EVENT_IOC_ENABLE, 0);
+
+    struct timespec timeout = { 0, WORKER_TIMEOUT_NS };
+    siginfo_t info;
+    while (!atomic_load_explicit(&stop_workers, memory_order_relaxed)) {
+        int sig = sigtimedwait(&channel_mask, &info, &timeout);
+        if (sig <= 0)
+            continue;
+        uint64_t now = mono_ns();
+        hist_record(&w->hist, now - (uint64_t)(uintptr_t)info.si_value.sival_ptr);
+
+        /* The shard's data lives wherever its owner has been touching it */
+        int shard = rt_channel_of(sig) % nworkers;
+        if (shard != w->index)
+            w->off_shard++;
+        uint64_t *state = shard_state[shard];
+        for (int i = 0; i < TOUCH_PER_MSG; i++)
+            state[(now + (uint64_t)i * 521) % STATE_WORDS]++;
+        atomic_fetch_add_explicit(&w->received, 1, memory_order_relaxed);
+    }
+
+    w->cache_misses = perf_read(misses_fd);
+    w->switches = perf_read(switch_fd);
+    router_unregister(&router, w->index);
+    if (misses_fd >= 0)
+        close(misses_fd);
+    if (switch_fd >= 0)
+        close(switch_fd);
+    return NULL;
+}
+
+/* Forked sender: @p total messages at @p rate, round-robin over @p channels */
+static void sender(enum mode m, pid_t receiver, long total, double rate, int channels)
+{
+    uint64_t period = (uint64_t)(1e9 / rate);
+    uint64_t start = mono_ns();
+
+    for (long i = 0; i < total; i++) {
+        uint64_t due = start + (uint64_t)i * period;
+        struct timespec ts = { (time_t)(due / 1000000000ull), (long)(due % 1000000000ull) };
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+            ;
+
+        int channel = (int)(i % channels);
+        int signo = rt_channel_signo(channel);
+        for (;;) {
+            union sigval v;
+            v.sival_ptr = (void *)(uintptr_t)mono_ns();
+            int rc = m == THREAD ? router_send(&router, signo, channel, v)
+                                 : sigqueue(receiver, signo, v);
+            if (rc == 0)
+                break;
+            if (errno != EAGAIN)
+                _exit(1);
+            sched_yield();
+        }
+    }
+    _exit(0);
+}
+
+static void run_mode(enum mode m, long total, double rate, int channels)
+{
+    atomic_store(&stop_workers, 0);
+    for (int i = 0; i < nworkers; i++) {
+        struct worker *w = &workers[i];
+        atomic_store(&w->received, 0);
+        w->off_shard = 0;
+        w->index = i;
+        hist_init(&w->hist);
+        pthread_create(&w->thread, NULL, worker_main, w);
+    }
+    /* Let every worker register its route before the first message */
+    for (int i = 0; i < nworkers; i++)
+        while (atomic_load(&router.table->tids[i]) == 0)
+            sched_yield();
+
+    uint64_t start = mono_ns();
+    pid_t child = fork();
+    if (child == 0)
+        sender(m, getppid(), total, rate, channels);
+    int status = 0;
+    waitpid(child, &status, 0);
+    uint64_t sent_done = mono_ns();
+
+    uint64_t got = 0;
+    while (mono_ns() - sent_done < DRAIN_TIMEOUT_NS) {
+        got = 0;
+        for (int i = 0; i < nworkers; i++)
+            got += atomic_load(&workers[i].received);
+        if (got >= (uint64_t)total)
+            break;
+        struct timespec pause = { 0, 1000000 };
+        nanosleep(&pause, NULL);
+    }
+    double secs = (mono_ns() - start) / 1e9;
+    atomic_store(&stop_workers, 1);
+
+    static struct latency_hist all;
+    hist_init(&all);
+    uint64_t off = 0, misses = 0, switches = 0;
+    int have_misses = 1;
+    for (int i = 0; i < nworkers; i++) {
+        pthread_join(workers[i].thread, NULL);
+        hist_merge(&all, &workers[i].hist);
+        off += workers[i].off_shard;
+        switches += workers[i].switches;
+        if (workers[i].cache_misses == UINT64_MAX)
+            have_misses = 0;
+        else
+            misses += workers[i].cache_misses;
+    }
+
+    char miss_text[32] = "n/a";
+    if (have_misses && got > 0)
+        snprintf(miss_text, sizeof(miss_text), "%.1f", (double)misses / got);
+    printf("%-8s %8llu msgs %9.0f msg/s  off-shard %5.1f%%  p50 %7.2f us  p99 %8.2f us  "
+           "p99.9 %8.2f us  cache-misses/msg %s  ctx-switches/msg %.2f%s\n",
+           mode_names[m], (unsigned long long)got, got / secs, got ? 100.0 * off / got : 0.0,
+           hist_percentile(&all, 50) / 1e3, hist_percentile(&all, 99) / 1e3,
+           hist_percentile(&all, 99.9) / 1e3, miss_text, got ? (double)switches / got : 0.0,
+           WIFEXITED(status) && WEXITSTATUS(status) == 0 ? "" : "  (sender failed)");
+}
+
+int main(int argc, char *argv[])
+{
+    long total = DEFAULT_MESSAGES;
+    double rate = DEFAULT_RATE;
+    int channels = 0;
+    int opt;
+
+    nworkers = online_cpus() > 2 ? online_cpus() : 2;
+    while ((opt = getopt(argc, argv, "w:n:R:k:")) != -1) {
+        switch (opt) {
+        case 'w':
+            nworkers = atoi(optarg);
+            break;
+        case 'n':
+            total = atol(optarg);
+            break;
+        case 'R':
+            rate = atof(optarg);
+            break;
+        case 'k':
+            channels = atoi(optarg);
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-w workers] [-n messages] [-R rate] [-k channels]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+    if (channels == 0)
+        channels = nworkers * 2 <= rt_channel_count() ? nworkers * 2 : rt_channel_count();
+    if (nworkers < 1 || nworkers > ROUTE_MAX_SHARDS || total < 1 || rate <= 0 ||
+        channels < 1 || channels > rt_channel_count()) {
+        fprintf(stderr, "bad arguments (1..%d workers, 1..%d channels)\n",
+                ROUTE_MAX_SHARDS, rt_channel_count());
+        return 1;
+    }
+
+    /* Block the channels everywhere first; workers take them with sigtimedwait() */
+    sigemptyset(&channel_mask);
+    for (int ch = 0; ch < channels; ch++)
+        sigaddset(&channel_mask, rt_channel_signo(ch));
+    pthread_sigmask(SIG_BLOCK, &channel_mask, NULL);
+
+    char name[64];
+    snprintf(name, sizeof(name), "/bench_route.%d", (int)getpid());
+    if (router_create(&router, name, nworkers, ROUTE_BY_CHANNEL) == -1)
+        return 1;
+
+    printf("%d workers pinned to %d CPU(s), %d channels, %ld messages at %.0f msg/s per mode\n",
+           nworkers, online_cpus(), channels, total, rate);
+    run_mode(PROCESS, total, rate, channels);
+    run_mode(THREAD, total, rate, channels);
+
+    router_close(&router, name);
+    return 0;
+}
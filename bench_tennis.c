@@ -0,0 +1,171 @@
+/**
+ * @file        : bench_tennis.c
+ * @brief       : Zero-sleep "Signal Tennis" rally that measures cross-process signal latency.
+ *
+ * Details      :
+ * - Forks a returning player and rallies SIGUSR1/sigqueue() volleys with it
+ *   for N volleys, with no sleeps, no beeps and no per-volley printing.
+ * - Every round trip is timed with CLOCK_MONOTONIC and recorded into a
+ *   log-linear histogram.
+ * - Reports p50/p99/p99.9/max RTT and volleys per second.
+ * - Runs the rally once per wait mode (-w, default all): blocking
+ *   sigwaitinfo(), zero-timeout sigtimedwait() spinning and signalfd
+ *   spinning, each spinning for -b microseconds before it blocks. The CPU
+ *   time both players used is reported next to the latency, which is the
+ *   price of the spin.
+ * - -P runs both players SCHED_FIFO, -L locks their memory and -c pins the
+ *   server to CPU 0 and the returner to CPU 1.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Extra Credit – Signal Tennis
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ *
+ * Compile      : make bench_tennis
+ * Usage        : ./bench_tennis [-n volleys] [-w block|spin|fd-spin|all] [-b spin_us] [-P prio] [-L] [-c]
+ * Example      : ./bench_tennis -n 1000000 -w all -b 1000 -P 50 -L -c
+ *
+ * Algorithm
+ *  1. Block SIGUSR1/SIGUSR2 so neither player can miss a ball.
+ *  2. For each wait mode: fork; the child returns every ball, the parent serves.
+ *  3. The parent times each round trip until N volleys have been hit.
+ *  4. Reap the child and print the latency/throughput/CPU summary.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include "latency_hist.h"
+#include "tennis_rally.h"
+#include "cpu_affinity.h"
+
+#define DEFAULT_VOLLEYS 100000L
+
+/* Low-latency settings applied to both players */
+static int fifo_priority = 0;
+static int lock_memory = 0;
+static int pin = 0;
+
+static double cpu_seconds(int who)
+{
+    struct rusage ru;
+    getrusage(who, &ru);
+    return ru.ru_utime.tv_sec + ru.ru_utime.tv_usec / 1e6 +
+           ru.ru_stime.tv_sec + ru.ru_stime.tv_usec / 1e6;
+}
+
+/* One rally with both players waiting in @p mode; returns 0 on success */
+static int run_mode(enum rally_wait mode, uint64_t spin_ns, long volleys)
+{
+    rally_set_wait(mode, spin_ns);
+    double cpu0 = cpu_seconds(RUSAGE_SELF) + cpu_seconds(RUSAGE_CHILDREN);
+
+    pid_t child = fork();
+    if (child == -1) {
+        perror("fork");
+        return -1;
+    }
+    if (child == 0) {
+        rally_realtime(pin ? 1 : -1, fifo_priority, lock_memory);
+        _exit(rally_return(volleys) < 0 ? 1 : 0);
+    }
+
+    static struct latency_hist rtt;
+    hist_init(&rtt);
+
+    printf("[BENCH] %s: rallying %ld volleys with PID %d...\n", rally_wait_name(mode), volleys, child);
+    fflush(stdout);
+
+    uint64_t start = mono_ns();
+    long done = rally_serve(child, volleys, &rtt);
+    uint64_t elapsed = mono_ns() - start;
+
+    int status = 0;
+    waitpid(child, &status, 0);
+    if (done < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        fprintf(stderr, "[BENCH] %s: rally aborted\n", rally_wait_name(mode));
+        return -1;
+    }
+
+    double secs = elapsed / 1e9;
+    double cpu = cpu_seconds(RUSAGE_SELF) + cpu_seconds(RUSAGE_CHILDREN) - cpu0;
+    char label[64];
+    snprintf(label, sizeof(label), "[BENCH] %s RTT", rally_wait_name(mode));
+    printf("[BENCH] %s: %ld volleys in %.3f s = %.0f volleys/s, CPU %.0f%% of one core\n",
+           rally_wait_name(mode), done, secs, done / secs, 100.0 * cpu / secs);
+    hist_print(&rtt, label, stdout);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    long volleys = DEFAULT_VOLLEYS;
+    uint64_t spin_ns = RALLY_DEFAULT_SPIN_NS;
+    int first = 0, last = RALLY_WAIT_MODES - 1;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:w:b:P:Lc")) != -1) {
+        switch (opt) {
+        case 'n':
+            volleys = atol(optarg);
+            break;
+        case 'w':
+            if (strcmp(optarg, "all") == 0)
+                break;
+            for (first = 0; first < RALLY_WAIT_MODES; first++)
+                if (strcmp(optarg, rally_wait_name(first)) == 0)
+                    break;
+            if (first == RALLY_WAIT_MODES)
+                goto usage;
+            last = first;
+            break;
+        case 'b':
+            spin_ns = (uint64_t)atol(optarg) * 1000;
+            break;
+        case 'P':
+            fifo_priority = atoi(optarg);
+            break;
+        case 'L':
+            lock_memory = 1;
+            break;
+        case 'c':
+            pin = 1;
+            break;
+        default:
+            goto usage;
+        }
+    }
+    if (volleys < 2) {
+        fprintf(stderr, "volleys must be at least 2\n");
+        return 1;
+    }
+
+    if (rally_block_signals() == -1)
+        return 1;
+    /* The server's half; each returner applies its own after fork() */
+    if (rally_realtime(pin ? 0 : -1, fifo_priority, lock_memory) == -1)
+        fprintf(stderr, "[BENCH] continuing without the settings that failed\n");
+
+    printf("[BENCH] %s, spin budget %.0f us, %d CPU(s)%s%s\n",
+           fifo_priority > 0 ? "SCHED_FIFO" : "SCHED_OTHER", spin_ns / 1e3, online_cpus(),
+           lock_memory ? ", memory locked" : "", pin ? ", pinned to CPUs 0/1" : "");
+    if (last > RALLY_WAIT_BLOCK && online_cpus() < 2)
+        printf("[BENCH] note: both players share a CPU, so spinning only delays the opponent\n");
+
+    int failed = 0;
+    for (int m = first; m <= last; m++)
+        if (run_mode((enum rally_wait)m, spin_ns, volleys) == -1)
+            failed = 1;
+    return failed;
+
+usage:
+    fprintf(stderr, "Usage: %s [-n volleys] [-w block|spin|fd-spin|all] [-b spin_us] [-P prio] [-L] [-c]\n",
+            argv[0]);
+    return 1;
+}
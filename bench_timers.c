@@ -0,0 +1,189 @@
+/**
+ * @file        : bench_timers.c
+ * @brief       : Throughput and jitter benchmark for the hierarchical timer wheel.
+ *
+ * Details      :
+ * - Insert, cancel and reschedule: N timers with random expiries up to
+ *   ~16 million ticks ahead; reports ns per operation.
+ * - Fire: N timers due within the next 65536 ticks, then the wheel is advanced
+ *   through all of them; reports ns per fired timer (cascades included).
+ * - Jitter: J timers spread over one second on a real 100 us wheel driven by
+ *   a timer_create() SIGALRM tick; reports lateness percentiles.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ *
+ * Compile      : make bench_timers
+ * Usage        : ./bench_timers [-n timers] [-j jitter_timers] [-r tick_us]
+ * Example      : ./bench_timers -n 1000000 -j 10000
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include "timer_wheel.h"
+#include "latency_hist.h"
+
+#define DEFAULT_TIMERS        100000L
+#define DEFAULT_JITTER_TIMERS 10000L
+
+struct bench_timer
+{
+    struct tw_timer timer;
+    uint64_t due_ns;
+};
+
+static long fired = 0;
+static struct latency_hist lateness;
+
+static void count_fire(struct tw_timer *timer, void *arg)
+{
+    (void)timer;
+    (void)arg;
+    fired++;
+}
+
+static void record_fire(struct tw_timer *timer, void *arg)
+{
+    (void)timer;
+    struct bench_timer *bt = arg;
+    uint64_t now = mono_ns();
+    hist_record(&lateness, now > bt->due_ns ? now - bt->due_ns : 0);
+    fired++;
+}
+
+static void report(const char *what, long ops, uint64_t ns)
+{
+    printf("%-12s %10ld ops %10.1f ns/op %12.0f ops/s\n",
+           what, ops, (double)ns / ops, ops / (ns / 1e9));
+}
+
+/* Pure data-structure throughput; the wheel is advanced by hand */
+static void bench_ops(long n)
+{
+    static struct timer_wheel wheel;
+    struct bench_timer *timers = calloc((size_t)n, sizeof(*timers));
+    uint64_t *when = malloc((size_t)n * sizeof(*when));
+    if (timers == NULL || when == NULL) {
+        perror("malloc");
+        exit(1);
+    }
+
+    tw_init(&wheel, 1000);
+    for (long i = 0; i < n; i++) {
+        tw_timer_init(&timers[i].timer, count_fire, NULL);
+        when[i] = 1 + (uint64_t)rand() % (1u << 24);
+    }
+
+    uint64_t t0 = mono_ns();
+    for (long i = 0; i < n; i++)
+        tw_add(&wheel, &timers[i].timer, when[i]);
+    report("insert", n, mono_ns() - t0);
+
+    t0 = mono_ns();
+    for (long i = 0; i < n; i++)
+        tw_reschedule(&wheel, &timers[i].timer, when[n - 1 - i]);
+    report("reschedule", n, mono_ns() - t0);
+
+    t0 = mono_ns();
+    for (long i = 0; i < n; i++)
+        tw_cancel(&wheel, &timers[i].timer);
+    report("cancel", n, mono_ns() - t0);
+
+    /* Fire: everything due in the next 2^16 ticks, so levels 0 and 1 are used */
+    for (long i = 0; i < n; i++)
+        tw_add(&wheel, &timers[i].timer, wheel.now + 1 + (uint64_t)rand() % 65536);
+    fired = 0;
+    t0 = mono_ns();
+    tw_advance(&wheel, wheel.now + 65538);
+    report("fire", fired, mono_ns() - t0);
+
+    free(when);
+    free(timers);
+}
+
+/* Real-time firing accuracy on a signal-driven wheel */
+static void bench_jitter(long n, long tick_us)
+{
+    static struct timer_wheel wheel;
+    struct bench_timer *timers = calloc((size_t)n, sizeof(*timers));
+    if (timers == NULL) {
+        perror("calloc");
+        exit(1);
+    }
+
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGALRM);
+    sigprocmask(SIG_BLOCK, &mask, NULL);
+
+    tw_init(&wheel, (uint64_t)tick_us * 1000);
+    hist_init(&lateness);
+
+    uint64_t start = mono_ns();
+    for (long i = 0; i < n; i++) {
+        timers[i].due_ns = start + 1000000 + (uint64_t)rand() % 1000000000u;
+        tw_timer_init(&timers[i].timer, record_fire, &timers[i]);
+        tw_add(&wheel, &timers[i].timer,
+               (timers[i].due_ns - wheel.origin_ns + wheel.tick_ns - 1) / wheel.tick_ns);
+    }
+
+    if (tw_start_clock(&wheel, SIGALRM) == -1)
+        exit(1);
+
+    fired = 0;
+    long ticks = 0;
+    while (fired < n) {
+        int sig;
+        sigwait(&mask, &sig);
+        ticks++;
+        tw_run(&wheel);
+    }
+    tw_stop_clock(&wheel);
+
+    printf("jitter: %ld timers over 1 s on a %ld us wheel, %ld tick signals\n",
+           n, tick_us, ticks);
+    hist_print(&lateness, "lateness", stdout);
+    free(timers);
+}
+
+int main(int argc, char *argv[])
+{
+    long n = DEFAULT_TIMERS;
+    long jitter = DEFAULT_JITTER_TIMERS;
+    long tick_us = 100;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:j:r:")) != -1) {
+        switch (opt) {
+        case 'n':
+            n = atol(optarg);
+            break;
+        case 'j':
+            jitter = atol(optarg);
+            break;
+        case 'r':
+            tick_us = atol(optarg);
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-n timers] [-j jitter_timers] [-r tick_us]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (n < 1 || tick_us < 1) {
+        fprintf(stderr, "timers and tick must be positive\n");
+        return 1;
+    }
+
+    srand(1);
+    bench_ops(n);
+    if (jitter > 0)
+        bench_jitter(jitter, tick_us);
+    return 0;
+}
@@ -0,0 +1,53 @@
+/**
+ * @file        : cpu_affinity.c
+ * @brief       : Small helpers for pinning threads and processes to CPUs.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+/* CPU_SET and pthread_setaffinity_np() are GNU extensions */
+#define _GNU_SOURCE
+#include "cpu_affinity.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+int online_cpus(void)
+{
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n < 1 ? 1 : (int)n;
+}
+
+int pin_thread_to_cpu(int cpu)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu % online_cpus(), &set);
+
+    int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (err != 0) {
+        fprintf(stderr, "pthread_setaffinity_np: %s\n", strerror(err));
+        return -1;
+    }
+    return 0;
+}
+
+int pin_process_to_cpu(pid_t pid, int cpu)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu % online_cpus(), &set);
+
+    if (sched_setaffinity(pid, sizeof(set), &set) == -1) {
+        perror("sched_setaffinity");
+        return -1;
+    }
+    return 0;
+}
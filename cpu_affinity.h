@@ -0,0 +1,26 @@
+/**
+ * @file        : cpu_affinity.h
+ * @brief       : Small helpers for pinning threads and processes to CPUs.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#ifndef CPU_AFFINITY_H
+#define CPU_AFFINITY_H
+
+#include <sys/types.h>
+
+/** @brief Number of CPUs currently online (at least 1). */
+int online_cpus(void);
+
+/** @brief Pin the calling thread to @p cpu (taken modulo online CPUs). @return 0 or -1. */
+int pin_thread_to_cpu(int cpu);
+
+/** @brief Pin process @p pid (0 = caller) to @p cpu (modulo online CPUs). @return 0 or -1. */
+int pin_process_to_cpu(pid_t pid, int cpu);
+
+#endif /* CPU_AFFINITY_H */
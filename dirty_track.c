@@ -0,0 +1,212 @@
+/**
+ * @file        : dirty_track.c
+ * @brief       : Write-protect fault dirty-page tracking for incremental snapshots.
+ *
+ * Details      :
+ * - The handler only reads the region table, sets one bitmap bit with an
+ *   atomic OR and calls mprotect(). As in lazy_mem.c, mprotect() is not on
+ *   the POSIX async-signal-safe list but is a plain system call on Linux.
+ * - dirty_snapshot() takes each bitmap word with an atomic exchange and
+ *   re-protects a run before copying it. When much of the region is dirty
+ *   it re-protects the whole region with one call after copying instead.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE /* MAP_ANONYMOUS */
+#include "dirty_track.h"
+
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "sigrt.h"
+
+/* Above 1/8 of the region dirty, one mprotect() of everything is cheaper
+   than one per run, and it merges the split mappings back into one */
+#define REPROTECT_ALL_SHIFT 3
+
+static struct dirty_region *_Atomic regions[DIRTY_MAX_REGIONS];
+static struct sigaction previous;
+static int installed = 0;
+static size_t page_size = 0;
+
+static void handle_fault(int signum, siginfo_t *info, void *context)
+{
+    uintptr_t addr = (uintptr_t)info->si_addr;
+
+    for (int i = 0; i < DIRTY_MAX_REGIONS; i++) {
+        struct dirty_region *r = atomic_load_explicit(&regions[i], memory_order_acquire);
+        if (r == NULL)
+            continue;
+
+        uintptr_t base = (uintptr_t)r->base;
+        if (addr < base || addr >= base + r->size)
+            continue;
+
+        size_t page = (addr - base) / page_size;
+        atomic_fetch_or_explicit(&r->bitmap[page / 64], 1ull << (page % 64), memory_order_relaxed);
+        int saved_errno = errno;
+        int ok = mprotect(r->base + page * page_size, page_size, PROT_READ | PROT_WRITE) == 0;
+        if (!ok && errno == ENOMEM) {
+            /* Out of mappings: stop tracking until the next snapshot (one mapping again) */
+            atomic_store_explicit(&r->all_dirty, 1, memory_order_relaxed);
+            ok = mprotect(r->base, r->size, PROT_READ | PROT_WRITE) == 0;
+        }
+        errno = saved_errno;
+        if (ok) {
+            atomic_fetch_add_explicit(&r->faults, 1, memory_order_relaxed);
+            return; /* re-execute the store */
+        }
+        break;
+    }
+
+    /* Not ours: whoever had SIGSEGV before us gets it */
+    sigrt_chain(signum, &previous, info, context);
+}
+
+int dirty_init(void)
+{
+    if (installed)
+        return 0;
+
+    page_size = (size_t)sysconf(_SC_PAGESIZE);
+
+    /* On the alternate stack shared with lazy_mem.c */
+    if (sigrt_fault_action(SIGSEGV, handle_fault, &previous) == -1)
+        return -1;
+
+    installed = 1;
+    return 0;
+}
+
+int dirty_create(struct dirty_region *r, size_t size)
+{
+    if (dirty_init() == -1)
+        return -1;
+
+    size = (size + page_size - 1) / page_size * page_size;
+    size_t pages = size / page_size;
+
+    void *base = mmap(NULL, size, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        perror("mmap");
+        return -1;
+    }
+    _Atomic uint64_t *bitmap = calloc((pages + 63) / 64, sizeof(*bitmap));
+    if (bitmap == NULL) {
+        perror("calloc");
+        munmap(base, size);
+        return -1;
+    }
+
+    r->base = base;
+    r->size = size;
+    r->pages = pages;
+    r->bitmap = bitmap;
+    atomic_store_explicit(&r->faults, 0, memory_order_relaxed);
+    atomic_store_explicit(&r->all_dirty, 0, memory_order_relaxed);
+
+    for (int i = 0; i < DIRTY_MAX_REGIONS; i++) {
+        struct dirty_region *expected = NULL;
+        if (atomic_compare_exchange_strong(&regions[i], &expected, r))
+            return 0;
+    }
+
+    fprintf(stderr, "dirty_create: more than %d regions\n", DIRTY_MAX_REGIONS);
+    free(bitmap);
+    munmap(base, size);
+    r->base = NULL;
+    return -1;
+}
+
+/* Copy pages [first, first + count), re-protecting them first unless the
+   whole region is re-protected at the end */
+static void snapshot_run(struct dirty_region *r, unsigned char *image, size_t first,
+                         size_t count, int protect)
+{
+    size_t off = first * page_size;
+    size_t len = count * page_size;
+    if (protect && mprotect(r->base + off, len, PROT_READ) == -1)
+        perror("mprotect");
+    memcpy(image + off, r->base + off, len);
+}
+
+size_t dirty_snapshot(struct dirty_region *r, unsigned char *image)
+{
+    size_t copied = 0;
+    size_t run_start = 0, run_len = 0;
+
+    if (atomic_exchange_explicit(&r->all_dirty, 0, memory_order_acq_rel)) {
+        for (size_t w = 0; w < (r->pages + 63) / 64; w++)
+            atomic_store_explicit(&r->bitmap[w], 0, memory_order_relaxed);
+        if (mprotect(r->base, r->size, PROT_READ) == -1)
+            perror("mprotect");
+        memcpy(image, r->base, r->size);
+        return r->pages;
+    }
+
+    int per_run = dirty_count(r) <= r->pages >> REPROTECT_ALL_SHIFT;
+
+    for (size_t w = 0; w < (r->pages + 63) / 64; w++) {
+        if (atomic_load_explicit(&r->bitmap[w], memory_order_relaxed) == 0)
+            continue; /* clean word: the common case for a mostly idle region */
+        uint64_t bits = atomic_exchange_explicit(&r->bitmap[w], 0, memory_order_acq_rel);
+
+        while (bits != 0) {
+            size_t page = w * 64 + (size_t)__builtin_ctzll(bits);
+            bits &= bits - 1;
+            if (run_len > 0 && page == run_start + run_len) {
+                run_len++;
+                continue;
+            }
+            if (run_len > 0)
+                snapshot_run(r, image, run_start, run_len, per_run);
+            copied += run_len;
+            run_start = page;
+            run_len = 1;
+        }
+    }
+    if (run_len > 0)
+        snapshot_run(r, image, run_start, run_len, per_run);
+    if (!per_run && mprotect(r->base, r->size, PROT_READ) == -1)
+        perror("mprotect");
+    return copied + run_len;
+}
+
+size_t dirty_count(const struct dirty_region *r)
+{
+    if (atomic_load_explicit(&r->all_dirty, memory_order_relaxed))
+        return r->pages;
+    size_t n = 0;
+    for (size_t w = 0; w < (r->pages + 63) / 64; w++)
+        n += (size_t)__builtin_popcountll(atomic_load_explicit(&r->bitmap[w], memory_order_relaxed));
+    return n;
+}
+
+size_t dirty_faults(const struct dirty_region *r)
+{
+    return atomic_load_explicit(&r->faults, memory_order_relaxed);
+}
+
+void dirty_destroy(struct dirty_region *r)
+{
+    for (int i = 0; i < DIRTY_MAX_REGIONS; i++) {
+        struct dirty_region *expected = r;
+        atomic_compare_exchange_strong(&regions[i], &expected, NULL);
+    }
+    if (r->base != NULL)
+        munmap(r->base, r->size);
+    free((void *)r->bitmap);
+    r->base = NULL;
+    r->bitmap = NULL;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file        : dirty_track.h
+ * @brief       : Write-protect fault dirty-page tracking for incremental snapshots.
+ *
+ * Details      :
+ * - dirty_create() maps a region and write-protects it (PROT_READ). The
+ *   first write to each page raises SIGSEGV; the handler sets that page's
+ *   bit in a dirty bitmap, mprotect()s the page read/write and returns, so
+ *   the store is re-executed and every later write to the page is free.
+ * - dirty_snapshot() copies only the dirty pages into a full-size image,
+ *   clears their bits and write-protects them again, one mprotect() per run
+ *   of consecutive dirty pages. A snapshot costs time proportional to what
+ *   changed, not to the size of the region.
+ * - Faults outside every tracked region are passed on to the SIGSEGV
+ *   handler that was installed before (lazy_mem.c, or the default action),
+ *   so both modules can be used in one program.
+ * - A snapshot is consistent when no other thread writes to the region
+ *   while it runs, the same rule as for a memcpy() snapshot.
+ * - Every unprotected page that is not next to another one is its own
+ *   mapping until the next snapshot merges them back. When the kernel runs
+ *   out of mappings (vm.max_map_count) the handler unprotects the whole
+ *   region and marks all of it dirty, so the next snapshot is a full copy
+ *   instead of the program crashing.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#ifndef DIRTY_TRACK_H
+#define DIRTY_TRACK_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Regions that can be tracked at the same time */
+#define DIRTY_MAX_REGIONS 16
+
+struct dirty_region
+{
+    unsigned char *base;
+    size_t size;                /* bytes, whole pages */
+    size_t pages;
+    _Atomic uint64_t *bitmap;   /* one bit per page, set on first write */
+    _Atomic size_t faults;      /* write faults taken so far */
+    _Atomic int all_dirty;      /* ran out of mappings: next snapshot copies everything */
+};
+
+/**
+ * @brief Install the SIGSEGV handler and an alternate signal stack.
+ *        Called automatically by dirty_create().
+ * @return 0 on success, -1 on failure.
+ */
+int dirty_init(void);
+
+/**
+ * @brief Map @p size zeroed bytes and start tracking writes to them.
+ * @return 0 on success, -1 on failure.
+ */
+int dirty_create(struct dirty_region *r, size_t size);
+
+/**
+ * @brief Copy every page written since the last snapshot into @p image
+ *        and re-arm tracking.
+ *
+ * @param image r->size bytes laid out like the region, holding the previous
+ *              snapshot (all zero before the first one).
+ * @return Number of pages copied.
+ */
+size_t dirty_snapshot(struct dirty_region *r, unsigned char *image);
+
+/** @brief Pages written since the last snapshot. */
+size_t dirty_count(const struct dirty_region *r);
+
+/** @brief Write faults taken so far. */
+size_t dirty_faults(const struct dirty_region *r);
+
+/** @brief Stop tracking and unmap the region. */
+void dirty_destroy(struct dirty_region *r);
+
+#endif /* DIRTY_TRACK_H */
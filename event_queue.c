@@ -0,0 +1,98 @@
+/**
+ * @file        : event_queue.c
+ * @brief       : Lock-free, async-signal-safe queue of signal events for the main loop.
+ *
+ * Details      :
+ * - Each slot holds a sequence number: seq == pos means free for the
+ *   producer reserving position pos, seq == pos + 1 means filled.
+ * - Producers reserve a position with compare-and-swap on tail, fill the
+ *   slot, then publish it by storing seq. The single consumer reads filled
+ *   slots in order and hands them back by advancing seq by the ring size.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "event_queue.h"
+
+#include <time.h>
+
+#define EQ_MASK (EVENT_QUEUE_SLOTS - 1)
+
+_Static_assert((EVENT_QUEUE_SLOTS & EQ_MASK) == 0, "EVENT_QUEUE_SLOTS must be a power of two");
+
+void eq_init(struct event_queue *q)
+{
+    for (uint64_t i = 0; i < EVENT_QUEUE_SLOTS; i++)
+        atomic_store_explicit(&q->slots[i].seq, i, memory_order_relaxed);
+    atomic_store_explicit(&q->head, 0, memory_order_relaxed);
+    atomic_store_explicit(&q->dropped, 0, memory_order_relaxed);
+    atomic_store_explicit(&q->tail, 0, memory_order_release);
+}
+
+int eq_push(struct event_queue *q, int signo, const siginfo_t *info)
+{
+    uint64_t pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    struct event_slot *slot;
+
+    while (1) {
+        slot = &q->slots[pos & EQ_MASK];
+        uint64_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        int64_t diff = (int64_t)(seq - pos);
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&q->tail, &pos, pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            atomic_fetch_add_explicit(&q->dropped, 1, memory_order_relaxed);
+            return -1;
+        } else {
+            pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+        }
+    }
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    slot->ev.signo = signo;
+    slot->ev.ts_ns = (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+    if (info != NULL) {
+        slot->ev.code = info->si_code;
+        slot->ev.pid = info->si_pid;
+        slot->ev.value = info->si_value;
+        slot->ev.addr = info->si_addr;
+    } else {
+        slot->ev.code = 0;
+        slot->ev.pid = 0;
+        slot->ev.value.sival_ptr = NULL;
+        slot->ev.addr = NULL;
+    }
+
+    atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+    return 0;
+}
+
+int eq_pop(struct event_queue *q, struct sig_event *ev)
+{
+    uint64_t pos = atomic_load_explicit(&q->head, memory_order_relaxed);
+    struct event_slot *slot = &q->slots[pos & EQ_MASK];
+
+    if (atomic_load_explicit(&slot->seq, memory_order_acquire) != pos + 1)
+        return 0;
+
+    *ev = slot->ev;
+    atomic_store_explicit(&slot->seq, pos + EVENT_QUEUE_SLOTS, memory_order_release);
+    atomic_store_explicit(&q->head, pos + 1, memory_order_relaxed);
+    return 1;
+}
+
+uint64_t eq_dropped(struct event_queue *q)
+{
+    return atomic_load_explicit(&q->dropped, memory_order_relaxed);
+}
@@ -0,0 +1,74 @@
+/**
+ * @file        : event_queue.h
+ * @brief       : Lock-free, async-signal-safe queue of signal events for the main loop.
+ *
+ * Details      :
+ * - Signal handlers call eq_push() with their siginfo_t; it only does a few
+ *   atomic loads/stores and one clock_gettime(), all async-signal-safe.
+ * - The main loop drains the queue with eq_pop() and does all formatting
+ *   and printing itself, in batches, outside of signal context.
+ * - Bounded multi-producer ring (per-slot sequence numbers), so a handler
+ *   interrupted by another handler mid-push cannot corrupt or deadlock it.
+ *   When the ring is full the event is counted in "dropped" instead.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+/* Ring size, must be a power of two */
+#define EVENT_QUEUE_SLOTS 4096
+
+/** One signal as seen by a handler */
+struct sig_event
+{
+    int signo;
+    int code;            /* si_code */
+    pid_t pid;           /* si_pid */
+    union sigval value;  /* si_value */
+    void *addr;          /* si_addr (fault address for SIGSEGV/SIGBUS) */
+    uint64_t ts_ns;      /* CLOCK_MONOTONIC when the handler ran */
+};
+
+struct event_slot
+{
+    _Atomic uint64_t seq;
+    struct sig_event ev;
+};
+
+struct event_queue
+{
+    _Alignas(64) _Atomic uint64_t tail;    /* next slot to reserve (handlers) */
+    _Alignas(64) _Atomic uint64_t head;    /* next slot to consume (main loop) */
+    _Alignas(64) _Atomic uint64_t dropped; /* events lost to a full ring */
+    struct event_slot slots[EVENT_QUEUE_SLOTS];
+};
+
+/** @brief Prepare an empty queue. Call before installing handlers. */
+void eq_init(struct event_queue *q);
+
+/**
+ * @brief Record a signal. Async-signal-safe; call from a handler.
+ *
+ * @param info siginfo_t from an SA_SIGINFO handler, or NULL for a plain handler.
+ * @return 0 on success, -1 if the ring was full (event dropped).
+ */
+int eq_push(struct event_queue *q, int signo, const siginfo_t *info);
+
+/** @brief Take the oldest event. @return 1 if @p ev was filled, 0 if empty. */
+int eq_pop(struct event_queue *q, struct sig_event *ev);
+
+/** @brief Number of events dropped because the ring was full. */
+uint64_t eq_dropped(struct event_queue *q);
+
+#endif /* EVENT_QUEUE_H */
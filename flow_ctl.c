@@ -0,0 +1,235 @@
+/**
+ * @file        : flow_ctl.c
+ * @brief       : Credit-based flow control: windowed sender, acking receiver, EAGAIN retry.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "flow_ctl.h"
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+
+#include "sig_metrics.h"
+
+/* How long a sender waits for an ack before checking the peer is alive */
+#define ACK_TIMEOUT_NS 100000000L
+
+/* EAGAIN backoff bounds for flow_sigqueue() */
+#define BACKOFF_MIN_NS 1000L
+#define BACKOFF_MAX_NS 1000000L
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static int collect_acks(struct flow_sender *s, const struct timespec *timeout);
+
+int flow_sender_init(struct flow_sender *s, pid_t peer, uint32_t window)
+{
+    memset(s, 0, sizeof(*s));
+    s->peer = peer;
+    s->window = window > 0 ? window : 1;
+
+    /* Acks stay pending until flow_send() collects them */
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, FLOW_ACK_SIGNAL);
+    if (sigprocmask(SIG_BLOCK, &set, NULL) == -1)
+        return -1;
+
+    /* Hello: only announced senders are acked by the receiver */
+    union sigval hello;
+    hello.sival_int = (int)s->window;
+    if (flow_sigqueue(peer, FLOW_ACK_SIGNAL, hello, 0) == -1)
+        return -1;
+
+    /* Data must not overtake the hello: wait for the receiver's first ack */
+    struct timespec wait = { 0, ACK_TIMEOUT_NS };
+    uint64_t start = now_ns();
+    while (s->acks == 0) {
+        if (collect_acks(s, &wait) == -1)
+            return -1;
+        if (s->acks == 0 && now_ns() - start > FLOW_STALL_TIMEOUT_NS) {
+            errno = ETIMEDOUT;
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Apply one ack; stale (older) cumulative values are ignored */
+static void apply_ack(struct flow_sender *s, const siginfo_t *info)
+{
+    if (info->si_pid != s->peer)
+        return;
+    s->acks++;
+    uint32_t acked = (uint32_t)info->si_value.sival_int;
+    if ((int32_t)(acked - s->acked) > 0 && (int32_t)(s->sent - acked) >= 0)
+        s->acked = acked;
+}
+
+/* Collect every ack already pending, waiting up to @p timeout for the first */
+static int collect_acks(struct flow_sender *s, const struct timespec *timeout)
+{
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, FLOW_ACK_SIGNAL);
+
+    siginfo_t info;
+    if (sigtimedwait(&set, &info, timeout) == -1) {
+        if (errno != EAGAIN && errno != EINTR)
+            return -1;
+        /* No credit for a while: make sure there is still someone to give it.
+           A zero-timeout poll is the per-message fast path, so it never probes */
+        int waited = timeout->tv_sec != 0 || timeout->tv_nsec != 0;
+        if (errno == EAGAIN && waited && kill(s->peer, 0) == -1 && errno == ESRCH)
+            return -1;
+        return 0;
+    }
+    apply_ack(s, &info);
+
+    struct timespec zero = { 0, 0 };
+    while (sigtimedwait(&set, &info, &zero) > 0)
+        apply_ack(s, &info);
+    return 0;
+}
+
+int flow_send(struct flow_sender *s, int signo, union sigval value)
+{
+    struct timespec wait = { 0, ACK_TIMEOUT_NS };
+    struct timespec zero = { 0, 0 };
+
+    /* Pick up credit that already arrived without blocking */
+    if (collect_acks(s, &zero) == -1)
+        return -1;
+
+    if (s->sent - s->acked >= s->window) {
+        s->stalls++;
+        uint64_t stalled_at = now_ns();
+        while (s->sent - s->acked >= s->window) {
+            if (collect_acks(s, &wait) == -1)
+                return -1;
+            if (s->sent - s->acked >= s->window && now_ns() - stalled_at > FLOW_STALL_TIMEOUT_NS) {
+                errno = ETIMEDOUT; /* receiver is not returning credit */
+                return -1;
+            }
+        }
+    }
+
+    while (sigqueue(s->peer, signo, value) == -1) {
+        if (errno != EAGAIN)
+            return -1;
+        /* Queue shared with other senders is full: wait for the receiver to drain */
+        s->eagain++;
+        sm_queue_full(signo);
+        struct timespec brief = { 0, BACKOFF_MAX_NS };
+        if (collect_acks(s, &brief) == -1)
+            return -1;
+    }
+    s->sent++;
+    return 0;
+}
+
+void flow_receiver_init(struct flow_receiver *r, uint32_t every)
+{
+    memset(r, 0, sizeof(*r));
+    r->every = every;
+}
+
+/* Send the cumulative count to one peer; a failed ack stays owed until
+   the next message or flow_flush() gets one through */
+static void send_ack(struct flow_receiver *r, struct flow_peer *p)
+{
+    union sigval v;
+    v.sival_int = (int)p->consumed;
+    if (sigqueue(p->pid, FLOW_ACK_SIGNAL, v) == -1) {
+        r->acks_failed++;
+        /* ESRCH: the sender is gone and nobody is waiting for it */
+        p->owed = errno == EAGAIN;
+        return;
+    }
+    p->acked = p->consumed;
+    p->owed = 0;
+    r->acks_sent++;
+}
+
+/* Credit record for @p pid, or NULL if it never said hello */
+static struct flow_peer *find_peer(struct flow_receiver *r, pid_t pid)
+{
+    for (int i = 0; i < r->npeers; i++)
+        if (r->peers[i].pid == pid)
+            return &r->peers[i];
+    return NULL;
+}
+
+void flow_hello(struct flow_receiver *r, pid_t pid, uint32_t window)
+{
+    struct flow_peer *p = find_peer(r, pid);
+    if (p == NULL) {
+        if (r->npeers == FLOW_MAX_PEERS)
+            return; /* no room: this sender gets no credit and will time out */
+        p = &r->peers[r->npeers++];
+    }
+
+    /* A new hello from the same PID starts a new stream */
+    memset(p, 0, sizeof(*p));
+    p->pid = pid;
+    uint32_t half = window / 2 > 0 ? window / 2 : 1;
+    p->every = r->every != 0 && r->every < half ? r->every : half;
+    send_ack(r, p); /* "nothing consumed yet": the sender may start */
+}
+
+void flow_consumed(struct flow_receiver *r, pid_t pid)
+{
+    struct flow_peer *p = find_peer(r, pid);
+    if (p == NULL)
+        return;
+
+    p->consumed++;
+    if (p->consumed - p->acked >= p->every)
+        send_ack(r, p);
+}
+
+int flow_flush(struct flow_receiver *r)
+{
+    int owed = 0;
+    for (int i = 0; i < r->npeers; i++) {
+        struct flow_peer *p = &r->peers[i];
+        if (!p->owed)
+            continue;
+        send_ack(r, p);
+        owed += p->owed;
+    }
+    return owed;
+}
+
+int flow_sigqueue(pid_t pid, int signo, union sigval value, uint64_t max_wait_ns)
+{
+    long backoff = BACKOFF_MIN_NS;
+    uint64_t waited = 0;
+
+    while (sigqueue(pid, signo, value) == -1) {
+        if (errno != EAGAIN)
+            return -1;
+        sm_queue_full(signo);
+        if (max_wait_ns != 0 && waited >= max_wait_ns)
+            return -1; /* errno is still EAGAIN */
+
+        struct timespec pause = { 0, backoff };
+        nanosleep(&pause, NULL);
+        waited += (uint64_t)backoff;
+        if (backoff < BACKOFF_MAX_NS)
+            backoff *= 2;
+    }
+    return 0;
+}
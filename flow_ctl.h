@@ -0,0 +1,123 @@
+/**
+ * @file        : flow_ctl.h
+ * @brief       : Credit-based (windowed) flow control for sigqueue() senders.
+ *
+ * Details      :
+ * - A sender never has more than W messages in flight to one receiver, so it
+ *   cannot fill the receiver's share of RLIMIT_SIGPENDING and run into
+ *   EAGAIN storms or dropped payloads.
+ * - A sender opts in by sending FLOW_ACK_SIGNAL to the receiver first, with
+ *   its window in sival_int. Only senders that said hello are ever acked, so
+ *   a plain sender is never hit by a signal it does not handle.
+ * - The receiver answers the hello with an ack of 0 and the sender waits for
+ *   it: real-time signals are delivered lowest number first, so data sent
+ *   right away would overtake the hello and never be credited.
+ * - The receiver returns credit with FLOW_ACK_SIGNAL; its sival_int is the
+ *   cumulative number of messages consumed from that sender. Acks are
+ *   cumulative, so a lost or late ack is repaired by the next one.
+ * - The receiver acks every N messages, or every W/2 if that is smaller, so
+ *   a sender with a full window always gets credit back.
+ * - An ack refused with EAGAIN (the sender's RLIMIT_SIGPENDING is reached)
+ *   is owed, not dropped: the receiver calls flow_flush() before every
+ *   blocking wait and waits at most FLOW_RETRY_MS while any ack is owed, so
+ *   a sender whose last ack failed is not left stalled.
+ * - flow_sigqueue() is the plain retry-on-EAGAIN send used where the
+ *   protocol already limits the window (Signal Tennis has one ball in play).
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#ifndef FLOW_CTL_H
+#define FLOW_CTL_H
+
+#include <signal.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+/* Credit signal; reserved by rt_channel.h, never used as a data channel */
+#define FLOW_ACK_SIGNAL (SIGRTMAX)
+
+/* A sender gives up when a full window gets no credit for this long */
+#define FLOW_STALL_TIMEOUT_NS 2000000000ULL
+
+/* How long a receiver with owed acks waits before retrying them */
+#define FLOW_RETRY_MS 1
+
+/* Most senders one receiver keeps credit for */
+#define FLOW_MAX_PEERS 64
+
+/** Sender side of one flow-controlled stream */
+struct flow_sender
+{
+    pid_t peer;
+    uint32_t window;    /* most messages in flight */
+    uint32_t sent;      /* messages sent so far */
+    uint32_t acked;     /* highest cumulative ack received */
+    uint64_t acks;      /* ack signals received */
+    uint64_t stalls;    /* sends that had to wait for credit */
+    uint64_t eagain;    /* sigqueue() EAGAIN retries */
+};
+
+/** Credit owed to one sender */
+struct flow_peer
+{
+    pid_t pid;
+    uint32_t every;     /* ack interval for this sender */
+    uint32_t consumed;  /* messages consumed from this sender */
+    uint32_t acked;     /* value of the last ack sent */
+    int owed;           /* the last ack failed and must be resent */
+};
+
+/** Receiver side: one credit counter per sender */
+struct flow_receiver
+{
+    uint32_t every;     /* ack after this many messages (capped at W/2 per sender) */
+    int npeers;
+    struct flow_peer peers[FLOW_MAX_PEERS];
+    uint64_t acks_sent;
+    uint64_t acks_failed;
+};
+
+/**
+ * @brief Block FLOW_ACK_SIGNAL, announce a stream with @p window to @p peer
+ *        and wait until the peer acknowledges it.
+ * @return 0 on success, -1 on failure (errno set; ETIMEDOUT if the peer
+ *         never answered the hello).
+ */
+int flow_sender_init(struct flow_sender *s, pid_t peer, uint32_t window);
+
+/**
+ * @brief Send one message, first waiting for credit if W are in flight.
+ *        EAGAIN from sigqueue() also waits for an ack, then retries.
+ * @return 0 on success, -1 on error (errno set; ESRCH if the peer is gone,
+ *         ETIMEDOUT if it returned no credit for FLOW_STALL_TIMEOUT_NS).
+ */
+int flow_send(struct flow_sender *s, int signo, union sigval value);
+
+/** @brief Start crediting: ack after every @p every messages. */
+void flow_receiver_init(struct flow_receiver *r, uint32_t every);
+
+/** @brief Register the sender @p pid that announced @p window (its FLOW_ACK_SIGNAL). */
+void flow_hello(struct flow_receiver *r, pid_t pid, uint32_t window);
+
+/** @brief Count one message consumed from @p pid; acks registered senders when due. */
+void flow_consumed(struct flow_receiver *r, pid_t pid);
+
+/**
+ * @brief Resend every ack that failed earlier. Call before blocking.
+ * @return Number of acks still owed (wait at most FLOW_RETRY_MS if not 0).
+ */
+int flow_flush(struct flow_receiver *r);
+
+/**
+ * @brief sigqueue() that retries EAGAIN with a short exponential backoff.
+ * @param max_wait_ns Give up after this long (0 = retry forever).
+ * @return 0 on success, -1 on error or timeout (errno set).
+ */
+int flow_sigqueue(pid_t pid, int signo, union sigval value, uint64_t max_wait_ns);
+
+#endif /* FLOW_CTL_H */
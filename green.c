@@ -0,0 +1,285 @@
+/**
+ * @file        : green.c
+ * @brief       : Round-robin ucontext scheduler with guard-paged stacks and SIGALRM preemption.
+ *
+ * Details      :
+ * - "running" is only non-NULL while the CPU is on that task's own stack
+ *   with its context live: every place a task resumes sets it and every
+ *   place a task switches away clears it first. The tick handler preempts
+ *   only when it is set, so it can never save the scheduler's registers
+ *   into a task, whatever instruction the tick interrupts.
+ * - Finished tasks return through uc_link into the scheduler, which then
+ *   recycles the task slot and its stack.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE /* MAP_ANONYMOUS, MAP_NORESERVE, MAP_STACK */
+#include "green.h"
+
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+
+struct green_task
+{
+    ucontext_t ctx;
+    green_fn fn;
+    void *arg;
+    unsigned char *stack;   /* guard page + usable stack, NULL until first use */
+    int id;
+    int done;
+};
+
+static struct green_task *tasks;
+static int *free_ids;           /* stack of unused task slots */
+static int nfree;
+static int *runq;               /* circular queue of runnable task ids */
+static int rq_head, rq_len;
+static int max_tasks;
+static size_t stack_len;        /* usable bytes */
+static size_t page;
+static long slice;
+
+static ucontext_t sched_ctx;
+static struct green_task *scheduled;            /* task the scheduler resumed last */
+static struct green_task *volatile running;     /* task whose stack we are on, or NULL */
+static volatile sig_atomic_t preempt_off;
+static volatile sig_atomic_t preempt_pending;
+static struct green_stats stats;
+static struct sigaction old_alarm;
+static int alarm_installed;
+
+/* Tick: switch from the interrupted task back to the scheduler */
+static void on_tick(int signo, siginfo_t *info, void *context)
+{
+    (void)signo;
+    (void)info;
+    (void)context;
+
+    struct green_task *t = running;
+    if (t == NULL)
+        return; /* in the scheduler, or a task is mid-switch */
+    if (preempt_off) {
+        preempt_pending = 1;
+        stats.deferred++;
+        return;
+    }
+
+    int saved_errno = errno;
+    running = NULL;
+    stats.preemptions++;
+    /* SIGALRM stays blocked in the saved context until this handler returns */
+    swapcontext(&t->ctx, &sched_ctx);
+    running = t;
+    errno = saved_errno;
+}
+
+/* First code every task runs; returning resumes the scheduler via uc_link */
+static void task_entry(void)
+{
+    struct green_task *t = scheduled;
+    running = t;
+    t->fn(t->arg);
+    running = NULL;
+    t->done = 1;
+}
+
+/* Map a stack with a PROT_NONE guard page at its low end (stacks grow down) */
+static unsigned char *map_stack(void)
+{
+    unsigned char *p = mmap(NULL, stack_len + page, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_STACK, -1, 0);
+    if (p == MAP_FAILED)
+        return NULL;
+    if (mprotect(p, page, PROT_NONE) == -1) {
+        munmap(p, stack_len + page);
+        return NULL;
+    }
+    stats.stacks++;
+    return p;
+}
+
+int green_init(int ntasks, size_t stack_size, long slice_us)
+{
+    page = (size_t)sysconf(_SC_PAGESIZE);
+    if (stack_size == 0)
+        stack_size = GREEN_DEFAULT_STACK;
+    if (stack_size < GREEN_MIN_STACK)
+        stack_size = GREEN_MIN_STACK;
+    stack_len = (stack_size + page - 1) / page * page;
+    max_tasks = ntasks;
+    slice = slice_us;
+    memset(&stats, 0, sizeof(stats));
+
+    tasks = calloc((size_t)ntasks, sizeof(*tasks));
+    free_ids = calloc((size_t)ntasks, sizeof(*free_ids));
+    runq = calloc((size_t)ntasks, sizeof(*runq));
+    if (tasks == NULL || free_ids == NULL || runq == NULL) {
+        perror("calloc");
+        green_shutdown();
+        return -1;
+    }
+    /* Lowest ids first, so a small workload keeps reusing the same stacks */
+    for (int i = 0; i < ntasks; i++) {
+        tasks[i].id = i;
+        free_ids[i] = ntasks - 1 - i;
+    }
+    nfree = ntasks;
+    rq_head = rq_len = 0;
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_sigaction = on_tick;
+    sa.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    if (sigaction(SIGALRM, &sa, &old_alarm) == -1) {
+        perror("sigaction");
+        green_shutdown();
+        return -1;
+    }
+    alarm_installed = 1;
+    return 0;
+}
+
+static void rq_push(int id)
+{
+    runq[(rq_head + rq_len) % max_tasks] = id;
+    rq_len++;
+}
+
+static int rq_pop(void)
+{
+    int id = runq[rq_head];
+    rq_head = (rq_head + 1) % max_tasks;
+    rq_len--;
+    return id;
+}
+
+int green_spawn(green_fn fn, void *arg)
+{
+    int id = -1;
+
+    /* The scheduler touches the same lists; it must not run in the middle */
+    green_preempt_disable();
+    if (nfree == 0)
+        goto out;
+
+    struct green_task *t = &tasks[free_ids[nfree - 1]];
+    if (t->stack == NULL && (t->stack = map_stack()) == NULL)
+        goto out;
+    nfree--;
+
+    getcontext(&t->ctx);
+    t->ctx.uc_stack.ss_sp = t->stack + page;
+    t->ctx.uc_stack.ss_size = stack_len;
+    t->ctx.uc_link = &sched_ctx;
+    makecontext(&t->ctx, task_entry, 0);
+    t->fn = fn;
+    t->arg = arg;
+    t->done = 0;
+    rq_push(t->id);
+    stats.spawned++;
+    id = t->id;
+out:
+    green_preempt_enable();
+    return id;
+}
+
+void green_yield(void)
+{
+    struct green_task *t = running;
+    if (t == NULL)
+        return;
+    running = NULL;
+    stats.yields++;
+    swapcontext(&t->ctx, &sched_ctx);
+    running = t;
+}
+
+int green_self(void)
+{
+    struct green_task *t = running;
+    return t != NULL ? t->id : -1;
+}
+
+void green_preempt_disable(void)
+{
+    preempt_off++;
+}
+
+void green_preempt_enable(void)
+{
+    if (--preempt_off == 0 && preempt_pending) {
+        preempt_pending = 0;
+        green_yield();
+    }
+}
+
+/* Start or stop the periodic tick */
+static void set_tick(long us)
+{
+    struct itimerval it;
+    it.it_interval.tv_sec = us / 1000000;
+    it.it_interval.tv_usec = us % 1000000;
+    it.it_value = it.it_interval;
+    setitimer(ITIMER_REAL, &it, NULL);
+}
+
+void green_run(void)
+{
+    if (slice > 0)
+        set_tick(slice);
+
+    while (rq_len > 0) {
+        struct green_task *t = &tasks[rq_pop()];
+        scheduled = t;
+        stats.switches++;
+        swapcontext(&sched_ctx, &t->ctx);
+
+        /* Back from a yield, a preemption or the end of the task */
+        preempt_pending = 0;
+        if (t->done) {
+            stats.finished++;
+            free_ids[nfree++] = t->id;
+        } else {
+            rq_push(t->id);
+        }
+    }
+
+    if (slice > 0)
+        set_tick(0);
+}
+
+void green_get_stats(struct green_stats *out)
+{
+    *out = stats;
+}
+
+void green_shutdown(void)
+{
+    if (tasks != NULL)
+        for (int i = 0; i < max_tasks; i++)
+            if (tasks[i].stack != NULL)
+                munmap(tasks[i].stack, stack_len + page);
+    if (alarm_installed)
+        sigaction(SIGALRM, &old_alarm, NULL);
+    alarm_installed = 0;
+    free(tasks);
+    free(free_ids);
+    free(runq);
+    tasks = NULL;
+    free_ids = runq = NULL;
+    max_tasks = nfree = rq_len = 0;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file        : green.h
+ * @brief       : Preemptive M:1 green threads: ucontext tasks time-sliced by SIGALRM.
+ *
+ * Details      :
+ * - Each task is a makecontext() coroutine with its own stack from a pool.
+ *   Every stack has a PROT_NONE guard page below it, so an overflow faults
+ *   instead of silently corrupting the neighbouring stack. Stacks of
+ *   finished tasks are reused, and untouched stack pages never use memory,
+ *   so 10k+ tasks fit in one process (each stack costs two mappings of
+ *   vm.max_map_count).
+ * - green_run() is a round-robin scheduler: it swapcontext()s into the next
+ *   runnable task and gets control back when that task yields, finishes or
+ *   is preempted.
+ * - A periodic ITIMER_REAL tick delivers SIGALRM; its handler swaps from the
+ *   interrupted task straight back to the scheduler, so a task that never
+ *   yields still only runs for one time slice. When the task is resumed the
+ *   handler returns and the task continues where it was interrupted.
+ * - Everything runs in one kernel thread, so a task must not be preempted
+ *   while it holds a libc lock (malloc, stdio): wrap such calls in
+ *   green_preempt_disable()/green_preempt_enable(). A tick that lands inside
+ *   such a section is deferred until it ends.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#ifndef GREEN_H
+#define GREEN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Default per-task stack (usable bytes, guard page not included) */
+#define GREEN_DEFAULT_STACK (64 * 1024)
+
+/* Smallest stack accepted: the SIGALRM frame lands on the task's stack */
+#define GREEN_MIN_STACK (16 * 1024)
+
+typedef void (*green_fn)(void *arg);
+
+/** Scheduler counters */
+struct green_stats
+{
+    uint64_t spawned;
+    uint64_t finished;
+    uint64_t switches;      /* times a task was resumed */
+    uint64_t yields;        /* voluntary green_yield() calls */
+    uint64_t preemptions;   /* tasks interrupted by the tick */
+    uint64_t deferred;      /* ticks postponed by green_preempt_disable() */
+    uint64_t stacks;        /* stacks mapped (reused ones are not counted again) */
+};
+
+/**
+ * @brief Set up the runtime.
+ *
+ * @param max_tasks  Most tasks alive at the same time.
+ * @param stack_size Usable stack bytes per task (0 = GREEN_DEFAULT_STACK).
+ * @param slice_us   Time slice; 0 disables preemption (cooperative only).
+ * @return 0 on success, -1 on failure (message printed).
+ */
+int green_init(int max_tasks, size_t stack_size, long slice_us);
+
+/**
+ * @brief Create a runnable task that calls fn(arg). Callable from main or a task.
+ * @return Task id, or -1 if max_tasks are alive or no stack could be mapped.
+ */
+int green_spawn(green_fn fn, void *arg);
+
+/** @brief Give up the rest of the time slice (from a task). */
+void green_yield(void);
+
+/** @brief Id of the running task, or -1 outside of tasks. */
+int green_self(void);
+
+/** @brief Run tasks until all of them have finished. The tick only runs in here. */
+void green_run(void);
+
+/** @brief Keep the tick from preempting the calling task (nests). */
+void green_preempt_disable(void);
+
+/** @brief End a green_preempt_disable() section; yields if a tick was deferred. */
+void green_preempt_enable(void);
+
+/** @brief Copy the scheduler counters. */
+void green_get_stats(struct green_stats *out);
+
+/** @brief Unmap every stack and restore the previous SIGALRM action. */
+void green_shutdown(void);
+
+#endif /* GREEN_H */
@@ -0,0 +1,131 @@
+/**
+ * @file        : latency_hist.c
+ * @brief       : Log-linear latency histogram used by the benchmark programs.
+ *
+ * Details      :
+ * - Values below HIST_SUB_COUNT map 1:1 onto the first buckets.
+ * - Larger values are split by their most significant bit into a power-of-
+ *   two band, and each band is divided into HIST_HALF linear sub-buckets.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "latency_hist.h"
+
+#include <string.h>
+#include <time.h>
+
+/* Map a value onto its bucket index */
+static unsigned bucket_of(uint64_t v)
+{
+    if (v < HIST_SUB_COUNT)
+        return (unsigned)v;
+
+    unsigned msb = 63u - (unsigned)__builtin_clzll(v);
+    unsigned shift = msb - (HIST_SUB_BITS - 1);
+    unsigned sub = (unsigned)(v >> shift) - HIST_HALF;
+    return HIST_SUB_COUNT + (shift - 1) * HIST_HALF + sub;
+}
+
+/* Representative (mid-point) value of a bucket */
+static uint64_t value_of(unsigned idx)
+{
+    if (idx < HIST_SUB_COUNT)
+        return idx;
+
+    unsigned rel = idx - HIST_SUB_COUNT;
+    unsigned shift = rel / HIST_HALF + 1;
+    uint64_t low = (uint64_t)(rel % HIST_HALF + HIST_HALF) << shift;
+    return low + ((1ull << shift) >> 1);
+}
+
+void hist_init(struct latency_hist *h)
+{
+    memset(h, 0, sizeof(*h));
+    h->min = UINT64_MAX;
+}
+
+void hist_record(struct latency_hist *h, uint64_t value)
+{
+    h->buckets[bucket_of(value)]++;
+    h->count++;
+    h->sum += value;
+    if (value < h->min)
+        h->min = value;
+    if (value > h->max)
+        h->max = value;
+}
+
+void hist_merge(struct latency_hist *dst, const struct latency_hist *src)
+{
+    for (unsigned i = 0; i < HIST_BUCKETS; i++)
+        dst->buckets[i] += src->buckets[i];
+    dst->count += src->count;
+    dst->sum += src->sum;
+    if (src->min < dst->min)
+        dst->min = src->min;
+    if (src->max > dst->max)
+        dst->max = src->max;
+}
+
+uint64_t hist_percentile(const struct latency_hist *h, double pct)
+{
+    if (h->count == 0)
+        return 0;
+
+    /* Nearest-rank method: the 1-based rank ceil(pct/100 * count) */
+    double exact = pct * (double)h->count / 100.0;
+    uint64_t rank = (uint64_t)exact;
+    if ((double)rank < exact)
+        rank++;
+    if (rank < 1)
+        rank = 1;
+    if (rank > h->count)
+        rank = h->count;
+
+    uint64_t seen = 0;
+    for (unsigned i = 0; i < HIST_BUCKETS; i++)
+    {
+        seen += h->buckets[i];
+        if (seen >= rank)
+        {
+            uint64_t v = value_of(i);
+            /* Never report beyond the exact extremes we have seen */
+            if (v > h->max)
+                v = h->max;
+            if (v < h->min)
+                v = h->min;
+            return v;
+        }
+    }
+    return h->max;
+}
+
+void hist_print(const struct latency_hist *h, const char *label, FILE *out)
+{
+    if (h->count == 0)
+    {
+        fprintf(out, "%s: no samples\n", label);
+        return;
+    }
+
+    fprintf(out, "%s: n=%llu min=%.2fus p50=%.2fus p99=%.2fus p99.9=%.2fus max=%.2fus\n",
+            label, (unsigned long long)h->count,
+            h->min / 1e3,
+            hist_percentile(h, 50.0) / 1e3,
+            hist_percentile(h, 99.0) / 1e3,
+            hist_percentile(h, 99.9) / 1e3,
+            h->max / 1e3);
+}
+
+uint64_t mono_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
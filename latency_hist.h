@@ -0,0 +1,58 @@
+/**
+ * @file        : latency_hist.h
+ * @brief       : Fixed-size log-linear ("HDR-style") latency histogram.
+ *
+ * Details      :
+ * - Values are recorded in nanoseconds into buckets whose width grows
+ *   with the magnitude of the value, so every recorded value keeps
+ *   roughly 1% relative precision from 1 ns up to the full uint64_t range.
+ * - Recording is O(1) with no allocation; the whole histogram is a flat
+ *   struct, so it can live on the stack or in a MAP_SHARED mapping.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#ifndef LATENCY_HIST_H
+#define LATENCY_HIST_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+/* 2^HIST_SUB_BITS linear sub-buckets per power of two (~0.8% precision) */
+#define HIST_SUB_BITS  7
+#define HIST_SUB_COUNT (1u << HIST_SUB_BITS)
+#define HIST_HALF      (HIST_SUB_COUNT / 2)
+#define HIST_BUCKETS   (HIST_SUB_COUNT + (64 - HIST_SUB_BITS) * HIST_HALF)
+
+struct latency_hist
+{
+    uint64_t count;
+    uint64_t sum;
+    uint64_t min;
+    uint64_t max;
+    uint64_t buckets[HIST_BUCKETS];
+};
+
+/** @brief Reset a histogram to empty. */
+void hist_init(struct latency_hist *h);
+
+/** @brief Record one value (nanoseconds). */
+void hist_record(struct latency_hist *h, uint64_t value);
+
+/** @brief Add every sample of @p src into @p dst. */
+void hist_merge(struct latency_hist *dst, const struct latency_hist *src);
+
+/** @brief Value at percentile @p pct (0–100), or 0 when empty. */
+uint64_t hist_percentile(const struct latency_hist *h, double pct);
+
+/** @brief Print count/min/p50/p99/p99.9/max on one line. */
+void hist_print(const struct latency_hist *h, const char *label, FILE *out);
+
+/** @brief Current CLOCK_MONOTONIC time in nanoseconds. */
+uint64_t mono_ns(void);
+
+#endif /* LATENCY_HIST_H */
@@ -0,0 +1,127 @@
+/**
+ * @file        : lazy_mem.c
+ * @brief       : SIGSEGV-driven demand paging for huge, sparse virtual arrays.
+ *
+ * Details      :
+ * - The handler only reads the region table, calls mprotect() and bumps an
+ *   atomic counter. mprotect() is not on the POSIX async-signal-safe list,
+ *   but on Linux it is a plain system call with no user-space state.
+ * - If mprotect() fails (e.g. the mapping limit was hit) the handler restores
+ *   the previous action and returns, so the fault is reported normally.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE /* MAP_ANONYMOUS, MAP_NORESERVE */
+#include "lazy_mem.h"
+
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "sigrt.h"
+
+static struct lazy_region *_Atomic regions[LAZY_MAX_REGIONS];
+static struct sigaction previous;
+static int installed = 0;
+static size_t page_size = 0;
+
+static void handle_fault(int signum, siginfo_t *info, void *context)
+{
+    uintptr_t addr = (uintptr_t)info->si_addr;
+
+    for (int i = 0; i < LAZY_MAX_REGIONS; i++) {
+        struct lazy_region *r = atomic_load_explicit(&regions[i], memory_order_acquire);
+        if (r == NULL)
+            continue;
+
+        uintptr_t base = (uintptr_t)r->base;
+        if (addr < base || addr >= base + r->size)
+            continue;
+
+        uintptr_t start = base + (addr - base) / r->granule * r->granule;
+        size_t len = r->granule;
+        if (start + len > base + r->size)
+            len = base + r->size - start;
+
+        if (mprotect((void *)start, len, PROT_READ | PROT_WRITE) == 0) {
+            atomic_fetch_add_explicit(&r->faults, 1, memory_order_relaxed);
+            return; /* re-execute the access */
+        }
+        break;
+    }
+
+    /* Not ours: whoever had SIGSEGV before us gets it */
+    sigrt_chain(signum, &previous, info, context);
+}
+
+int lazy_init(void)
+{
+    if (installed)
+        return 0;
+
+    page_size = (size_t)sysconf(_SC_PAGESIZE);
+
+    /* The handler must run even if the fault came from a blown stack */
+    if (sigrt_fault_action(SIGSEGV, handle_fault, &previous) == -1)
+        return -1;
+
+    installed = 1;
+    return 0;
+}
+
+int lazy_reserve(struct lazy_region *r, size_t size, size_t granule)
+{
+    if (lazy_init() == -1)
+        return -1;
+
+    if (granule == 0)
+        granule = page_size;
+    granule = (granule + page_size - 1) / page_size * page_size;
+    size = (size + granule - 1) / granule * granule;
+
+    void *base = mmap(NULL, size, PROT_NONE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (base == MAP_FAILED) {
+        perror("mmap");
+        return -1;
+    }
+
+    r->base = base;
+    r->size = size;
+    r->granule = granule;
+    atomic_store_explicit(&r->faults, 0, memory_order_relaxed);
+
+    for (int i = 0; i < LAZY_MAX_REGIONS; i++) {
+        struct lazy_region *expected = NULL;
+        if (atomic_compare_exchange_strong(&regions[i], &expected, r))
+            return 0;
+    }
+
+    fprintf(stderr, "lazy_reserve: more than %d regions\n", LAZY_MAX_REGIONS);
+    munmap(base, size);
+    return -1;
+}
+
+void lazy_release(struct lazy_region *r)
+{
+    for (int i = 0; i < LAZY_MAX_REGIONS; i++) {
+        struct lazy_region *expected = r;
+        atomic_compare_exchange_strong(&regions[i], &expected, NULL);
+    }
+    if (r->base != NULL)
+        munmap(r->base, r->size);
+    r->base = NULL;
+}
+
+size_t lazy_faults(const struct lazy_region *r)
+{
+    return atomic_load_explicit(&r->faults, memory_order_relaxed);
+}
@@ -0,0 +1,63 @@
+/**
+ * @file        : lazy_mem.h
+ * @brief       : SIGSEGV-driven demand paging for huge, sparse virtual arrays.
+ *
+ * Details      :
+ * - lazy_reserve() maps a large PROT_NONE region (MAP_NORESERVE), so it costs
+ *   address space but no memory.
+ * - The first access to any granule faults; an SA_SIGINFO SIGSEGV handler
+ *   running on a sigaltstack reads si_addr, mprotect()s just that granule
+ *   read/write and returns, so the faulting instruction is re-executed and
+ *   succeeds. Only touched granules are ever backed by memory.
+ * - Faults outside every lazy region are passed on to the SIGSEGV handler
+ *   that was installed before lazy_init() (or the default action).
+ * - Each unlocked granule that is not adjacent to another one becomes its
+ *   own mapping, so very sparse patterns are limited by vm.max_map_count;
+ *   use a larger granule for those.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#ifndef LAZY_MEM_H
+#define LAZY_MEM_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+/* Regions that can be registered at the same time */
+#define LAZY_MAX_REGIONS 16
+
+struct lazy_region
+{
+    unsigned char *base;
+    size_t size;
+    size_t granule;             /* bytes unlocked per fault (page multiple) */
+    _Atomic size_t faults;      /* granules unlocked so far */
+};
+
+/**
+ * @brief Install the SIGSEGV handler and the calling thread's alternate
+ *        signal stack. Called automatically by lazy_reserve().
+ * @return 0 on success, -1 on failure.
+ */
+int lazy_init(void);
+
+/**
+ * @brief Reserve @p size bytes that are populated on first touch.
+ *
+ * @param granule Bytes unlocked per fault; 0 means one page.
+ * @return 0 on success, -1 on failure.
+ */
+int lazy_reserve(struct lazy_region *r, size_t size, size_t granule);
+
+/** @brief Unregister and unmap the region. */
+void lazy_release(struct lazy_region *r);
+
+/** @brief Granules unlocked by the fault handler so far. */
+size_t lazy_faults(const struct lazy_region *r);
+
+#endif /* LAZY_MEM_H */
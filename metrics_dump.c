@@ -0,0 +1,278 @@
+/**
+ * @file        : metrics_dump.c
+ * @brief       : Lists and prints the shared-memory signal metrics pages of running programs.
+ *
+ * Details      :
+ * - Without arguments lists every page in SIG_METRICS_DIR with its program,
+ *   PID and whether that process is still alive; -x also removes the pages
+ *   of processes that are gone (killed before sm_close() could run).
+ * - With PIDs (or page paths) prints one table per process: for every
+ *   signal with any activity the number handled, dropped (handler queue
+ *   full) and refused with EAGAIN, and the handling time mean, p50/p99
+ *   (log2 bucket upper bounds) and max.
+ * - By default it sends the process its snapshot signal and waits for the
+ *   snapshot count to move, so the table is one consistent copy. -L reads
+ *   the live counters instead and never makes a syscall that touches the
+ *   process: the way a scraper polling at high rate would read them.
+ *   -S prints the last snapshot the process took on its own (e.g.
+ *   signal_handler on SIGINT) without asking for a new one.
+ * - -i seconds repeats the dump until interrupted.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ *
+ * Compile      : make metrics_dump
+ * Usage        : ./metrics_dump [-x] | [-L | -S] [-i seconds] <pid | page> ...
+ * Example      : ./metrics_dump $(pgrep recv_signal)
+ *
+ * Algorithm
+ *  1. Resolve every argument to a page path and map it read-only.
+ *  2. Unless -L: note the snapshot count, send the snapshot signal and
+ *     wait (up to SNAPSHOT_TIMEOUT_NS) for the count to change.
+ *  3. Copy the snapshot under its sequence lock (or the live counters).
+ *  4. Print the active signals.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <dirent.h>
+#include <limits.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "sig_metrics.h"
+#include "latency_hist.h"
+
+/* How long to wait for a process to answer the snapshot signal */
+#define SNAPSHOT_TIMEOUT_NS 1000000000ULL
+#define MAX_PAGES 64
+
+static const char *signal_name(int signo, char *buf, size_t len)
+{
+    static const struct { int signo; const char *name; } names[] = {
+        { SIGHUP, "SIGHUP" },   { SIGINT, "SIGINT" },   { SIGQUIT, "SIGQUIT" },
+        { SIGILL, "SIGILL" },   { SIGABRT, "SIGABRT" }, { SIGBUS, "SIGBUS" },
+        { SIGFPE, "SIGFPE" },   { SIGUSR1, "SIGUSR1" }, { SIGSEGV, "SIGSEGV" },
+        { SIGUSR2, "SIGUSR2" }, { SIGPIPE, "SIGPIPE" }, { SIGALRM, "SIGALRM" },
+        { SIGTERM, "SIGTERM" }, { SIGCHLD, "SIGCHLD" }, { SIGPROF, "SIGPROF" },
+    };
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        if (names[i].signo == signo)
+            return names[i].name;
+    }
+    if (signo >= SIGRTMIN && signo <= SIGRTMAX) {
+        /* Named from whichever end is closer, as kill -l does */
+        if (signo - SIGRTMIN <= SIGRTMAX - signo)
+            snprintf(buf, len, "SIGRTMIN+%d", signo - SIGRTMIN);
+        else
+            snprintf(buf, len, "SIGRTMAX-%d", SIGRTMAX - signo);
+    } else {
+        snprintf(buf, len, "SIG%d", signo);
+    }
+    return buf;
+}
+
+/* Still running: kill(pid, 0) also succeeds on a zombie, so check its state too */
+static int process_alive(pid_t pid)
+{
+    if (pid <= 0 || (kill(pid, 0) == -1 && errno != EPERM))
+        return 0;
+    char path[64], state = '?';
+    snprintf(path, sizeof(path), "/proc/%d/stat", (int)pid);
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL)
+        return 0;
+    if (fscanf(fp, "%*d (%*[^)]) %c", &state) != 1)
+        state = '?';
+    fclose(fp);
+    return state != 'Z' && state != 'X';
+}
+
+/* Every page in SIG_METRICS_DIR; @p prune removes those of exited processes */
+static int list_pages(int prune)
+{
+    DIR *dir = opendir(SIG_METRICS_DIR);
+    if (dir == NULL) {
+        perror(SIG_METRICS_DIR);
+        return 1;
+    }
+    int found = 0;
+    struct dirent *de;
+    while ((de = readdir(dir)) != NULL) {
+        if (strncmp(de->d_name, SIG_METRICS_PREFIX, strlen(SIG_METRICS_PREFIX)) != 0)
+            continue;
+        const char *dot = strrchr(de->d_name, '.');
+        pid_t pid = (pid_t)atoi(dot + 1);
+        int alive = process_alive(pid);
+        char path[PATH_MAX];
+        snprintf(path, sizeof(path), "%s/%s", SIG_METRICS_DIR, de->d_name);
+        printf("%-48s PID %-7d %s\n", path, (int)pid, alive ? "running" : "exited");
+        if (!alive && prune && unlink(path) == 0)
+            printf("  removed\n");
+        found++;
+    }
+    closedir(dir);
+    if (found == 0)
+        printf("No metrics pages in %s\n", SIG_METRICS_DIR);
+    return 0;
+}
+
+/* A PID becomes the page of that PID, whatever the program is called */
+static int resolve(const char *arg, char *path, size_t len)
+{
+    if (strchr(arg, '/') != NULL) {
+        snprintf(path, len, "%s", arg);
+        return 0;
+    }
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), ".%d", atoi(arg));
+    DIR *dir = opendir(SIG_METRICS_DIR);
+    if (dir == NULL) {
+        perror(SIG_METRICS_DIR);
+        return -1;
+    }
+    int found = -1;
+    struct dirent *de;
+    while ((de = readdir(dir)) != NULL) {
+        size_t n = strlen(de->d_name), s = strlen(suffix);
+        if (strncmp(de->d_name, SIG_METRICS_PREFIX, strlen(SIG_METRICS_PREFIX)) == 0 &&
+            n > s && strcmp(de->d_name + n - s, suffix) == 0) {
+            snprintf(path, len, "%s/%s", SIG_METRICS_DIR, de->d_name);
+            found = 0;
+            break;
+        }
+    }
+    closedir(dir);
+    if (found == -1)
+        fprintf(stderr, "No metrics page for PID %s\n", arg);
+    return found;
+}
+
+/* Ask for a snapshot and wait until it has been taken */
+static int request_snapshot(const struct sm_page *p)
+{
+    uint64_t before = atomic_load((_Atomic uint64_t *)&p->snapshots);
+    if (kill(p->pid, p->snapshot_signo) == -1) {
+        perror("kill");
+        return -1;
+    }
+    uint64_t start = mono_ns();
+    while (atomic_load((_Atomic uint64_t *)&p->snapshots) == before) {
+        if (mono_ns() - start > SNAPSHOT_TIMEOUT_NS) {
+            fprintf(stderr, "PID %d did not take a snapshot\n", p->pid);
+            return -1;
+        }
+        struct timespec pause = { 0, 100000 };
+        nanosleep(&pause, NULL);
+    }
+    return 0;
+}
+
+static void print_page(const struct sm_page *p, int live)
+{
+    static struct sm_block block;
+    uint64_t now = mono_ns();
+    if (live) {
+        sm_read_live(p, &block);
+        printf("%s (PID %d), live counters, up %.1f s\n", p->program, p->pid,
+               (now - p->start_ns) / 1e9);
+    } else {
+        uint64_t n = sm_read_snapshot(p, &block);
+        uint64_t at = atomic_load((_Atomic uint64_t *)&p->snap_ns);
+        printf("%s (PID %d), snapshot #%llu taken %.1f s after start\n", p->program, p->pid,
+               (unsigned long long)n, (at - p->start_ns) / 1e9);
+    }
+
+    printf("  %-12s %12s %10s %10s %10s %10s %10s %10s\n", "signal", "handled", "dropped",
+           "queue_full", "mean_ns", "p50_ns<=", "p99_ns<=", "max_ns");
+    for (int s = 1; s < SIG_METRICS_SIGNALS; s++) {
+        const struct sm_counters *c = &block.sig[s];
+        uint64_t handled = atomic_load(&c->handled);
+        uint64_t dropped = atomic_load(&c->dropped);
+        uint64_t full = atomic_load(&c->queue_full);
+        if (handled == 0 && dropped == 0 && full == 0)
+            continue;
+        char buf[16];
+        printf("  %-12s %12llu %10llu %10llu %10.0f %10llu %10llu %10llu\n",
+               signal_name(s, buf, sizeof(buf)), (unsigned long long)handled,
+               (unsigned long long)dropped, (unsigned long long)full,
+               handled ? (double)atomic_load(&c->handle_ns) / handled : 0.0,
+               (unsigned long long)sm_percentile(c, 50.0), (unsigned long long)sm_percentile(c, 99.0),
+               (unsigned long long)atomic_load(&c->handle_max_ns));
+    }
+    fflush(stdout);
+}
+
+int main(int argc, char *argv[])
+{
+    int live = 0, prune = 0, last = 0;
+    double interval = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "xLSi:")) != -1) {
+        switch (opt) {
+        case 'x':
+            prune = 1;
+            break;
+        case 'L':
+            live = 1;
+            break;
+        case 'S':
+            last = 1;
+            break;
+        case 'i':
+            interval = atof(optarg);
+            break;
+        default:
+            goto usage;
+        }
+    }
+    if (optind == argc)
+        return list_pages(prune);
+    if (argc - optind > MAX_PAGES)
+        goto usage;
+
+    const struct sm_page *pages[MAX_PAGES];
+    int npages = 0;
+    for (int i = optind; i < argc; i++) {
+        char path[PATH_MAX];
+        if (resolve(argv[i], path, sizeof(path)) == -1)
+            continue;
+        const struct sm_page *p = sm_map(path);
+        if (p != NULL)
+            pages[npages++] = p;
+    }
+    if (npages == 0)
+        return 1;
+
+    int status = 0;
+    do {
+        for (int i = 0; i < npages; i++) {
+            if (!live && !last && request_snapshot(pages[i]) == -1) {
+                status = 1;
+                continue;
+            }
+            print_page(pages[i], live);
+        }
+        if (interval > 0) {
+            struct timespec pause = { (time_t)interval, (long)((interval - (time_t)interval) * 1e9) };
+            nanosleep(&pause, NULL);
+            printf("\n");
+        }
+    } while (interval > 0);
+
+    for (int i = 0; i < npages; i++)
+        sm_unmap(pages[i]);
+    return status;
+
+usage:
+    fprintf(stderr, "Usage: %s [-x] | [-L | -S] [-i seconds] <pid | page> ...\n", argv[0]);
+    return 1;
+}
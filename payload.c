@@ -0,0 +1,76 @@
+/**
+ * @file        : payload.c
+ * @brief       : Encoder/decoder for the 64-bit structured signal payload.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "payload.h"
+
+#include "latency_hist.h"
+
+#define CHAN_SHIFT PAYLOAD_SEQ_BITS
+#define OP_SHIFT   (PAYLOAD_SEQ_BITS + PAYLOAD_CHAN_BITS)
+#define TS_SHIFT   32
+
+static const char *op_names[] = { "none", "data", "ball", "end" };
+
+union sigval payload_encode(unsigned op, unsigned channel, uint32_t seq)
+{
+    uint64_t ts = (mono_ns() >> PAYLOAD_TS_SHIFT) & 0xffffffffull;
+    uint64_t raw = ts << TS_SHIFT |
+                   (uint64_t)(op & PAYLOAD_OP_MASK) << OP_SHIFT |
+                   (uint64_t)(channel & PAYLOAD_CHAN_MASK) << CHAN_SHIFT |
+                   (seq & PAYLOAD_SEQ_MASK);
+
+    /* Set the whole pointer, so no stale upper half goes out with it */
+    union sigval v;
+    v.sival_ptr = (void *)(uintptr_t)raw;
+    return v;
+}
+
+int payload_decode(uint64_t raw, struct payload *p)
+{
+    p->op = (unsigned)(raw >> OP_SHIFT) & PAYLOAD_OP_MASK;
+    /* Opcodes nobody encodes are the high bits of a plain int (any negative one) */
+    if (p->op == PAYLOAD_OP_NONE || p->op > PAYLOAD_OP_END) {
+        p->op = PAYLOAD_OP_NONE;
+        p->channel = 0;
+        p->seq = (uint32_t)raw;
+        p->ts = 0;
+        return -1;
+    }
+    p->channel = (unsigned)(raw >> CHAN_SHIFT) & PAYLOAD_CHAN_MASK;
+    p->seq = (uint32_t)raw & PAYLOAD_SEQ_MASK;
+    p->ts = (uint32_t)(raw >> TS_SHIFT);
+    return 0;
+}
+
+uint64_t payload_raw(union sigval v)
+{
+    return (uint64_t)(uintptr_t)v.sival_ptr;
+}
+
+uint64_t payload_age_ns(const struct payload *p, uint64_t now_ns)
+{
+    /* Unsigned 32-bit subtraction undoes the wrap of the truncated stamp */
+    uint32_t now = (uint32_t)(now_ns >> PAYLOAD_TS_SHIFT);
+    return (uint64_t)(uint32_t)(now - p->ts) << PAYLOAD_TS_SHIFT;
+}
+
+int32_t payload_seq_delta(uint32_t seq, uint32_t expected)
+{
+    /* Shift the 22-bit difference to the top and back to sign-extend it */
+    uint32_t diff = (seq - expected) & PAYLOAD_SEQ_MASK;
+    return (int32_t)(diff << (32 - PAYLOAD_SEQ_BITS)) >> (32 - PAYLOAD_SEQ_BITS);
+}
+
+const char *payload_op_name(unsigned op)
+{
+    return op < sizeof(op_names) / sizeof(op_names[0]) ? op_names[op] : "?";
+}
@@ -0,0 +1,101 @@
+/**
+ * @file        : payload.h
+ * @brief       : 64-bit structured signal payload: opcode, channel, sequence and send time in sival_ptr.
+ *
+ * Details      :
+ * - On Linux sigval is 64 bits wide but the programs only used sival_int.
+ *   The whole sival_ptr now carries:
+ *
+ *       63            32 31  28 27    22 21            0
+ *      +----------------+------+--------+---------------+
+ *      |  send time     |  op  |channel |   sequence    |
+ *      +----------------+------+--------+---------------+
+ *
+ * - The low half is what sival_int reads, so op is never 0 in an encoded
+ *   payload: a value with op 0 is a legacy plain sival_int (a random number,
+ *   a volley count, a window) and decodes as such. So does one whose op is
+ *   not a known opcode (above PAYLOAD_OP_END), which covers every negative
+ *   sival_int. The values that cannot be told apart from a payload are the
+ *   plain ints from 2^28 to 4 * 2^28 - 1 (op 1..3); an older sender must
+ *   keep its values below 2^28 to be read back exactly.
+ * - The send time is CLOCK_MONOTONIC in 16 ns units, truncated to 32 bits
+ *   (wraps every ~68 s). The receiver rebuilds it against its own clock,
+ *   which is the same clock on the same host, so any one-way delivery time
+ *   below the wrap is exact to 16 ns without a second side channel.
+ * - Sequence numbers are 22 bits and compared modulo 2^22, so a receiver can
+ *   tell a gap (loss) from an old message (reordering) per message.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#ifndef PAYLOAD_H
+#define PAYLOAD_H
+
+#include <signal.h>
+#include <stdint.h>
+
+#define PAYLOAD_SEQ_BITS  22
+#define PAYLOAD_CHAN_BITS 6
+#define PAYLOAD_OP_BITS   4
+
+#define PAYLOAD_SEQ_MASK  ((1u << PAYLOAD_SEQ_BITS) - 1)
+#define PAYLOAD_CHAN_MASK ((1u << PAYLOAD_CHAN_BITS) - 1)
+#define PAYLOAD_OP_MASK   ((1u << PAYLOAD_OP_BITS) - 1)
+
+/* Send time resolution: CLOCK_MONOTONIC ns >> PAYLOAD_TS_SHIFT */
+#define PAYLOAD_TS_SHIFT  4
+
+/** What a message means; 0 is reserved for legacy plain values */
+enum payload_op
+{
+    PAYLOAD_OP_NONE = 0,    /* not encoded: sival_int is a plain value */
+    PAYLOAD_OP_DATA = 1,    /* one message of a numbered stream */
+    PAYLOAD_OP_BALL = 2,    /* Signal Tennis volley, sequence = volley count */
+    PAYLOAD_OP_END  = 3     /* end of game / stream, sequence = last number */
+    /* Keep END the highest: anything above it decodes as a legacy value */
+};
+
+/** A decoded payload */
+struct payload
+{
+    unsigned op;        /* enum payload_op */
+    unsigned channel;
+    uint32_t seq;
+    uint32_t ts;        /* truncated send time, see PAYLOAD_TS_SHIFT */
+};
+
+/**
+ * @brief Pack @p op (1..15), @p channel and @p seq (truncated to their
+ *        fields) with the current CLOCK_MONOTONIC time.
+ */
+union sigval payload_encode(unsigned op, unsigned channel, uint32_t seq);
+
+/**
+ * @brief Unpack the 64-bit value of a received signal (si_value.sival_ptr
+ *        or signalfd's ssi_ptr).
+ * @return 0 for an encoded payload, -1 for a legacy value, including one
+ *         with an unknown opcode (@p p->seq then holds its sival_int and op
+ *         is PAYLOAD_OP_NONE).
+ */
+int payload_decode(uint64_t raw, struct payload *p);
+
+/** @brief The 64-bit value carried by @p v. */
+uint64_t payload_raw(union sigval v);
+
+/** @brief One-way delivery time of @p p if it arrived at @p now_ns (mono_ns()). */
+uint64_t payload_age_ns(const struct payload *p, uint64_t now_ns);
+
+/**
+ * @brief Signed distance from @p expected to @p seq modulo 2^22:
+ *        0 in order, > 0 that many numbers skipped, < 0 an older message.
+ */
+int32_t payload_seq_delta(uint32_t seq, uint32_t expected);
+
+/** @brief Name of @p op ("data", "ball", ...). */
+const char *payload_op_name(unsigned op);
+
+#endif /* PAYLOAD_H */
@@ -0,0 +1,169 @@
+/**
+ * @file        : peer_mgr.c
+ * @brief       : pidfd_open/pidfd_send_signal peer table watched by one epoll set.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE /* syscall() */
+#include "peer_mgr.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/syscall.h>
+
+#include "sig_metrics.h"
+
+/* glibc 2.36 has no wrappers yet; the syscall numbers are the same on every arch */
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434
+#endif
+#ifndef SYS_pidfd_send_signal
+#define SYS_pidfd_send_signal 424
+#endif
+
+/* Exit events taken per epoll_wait() call */
+#define EXIT_BATCH 64
+
+/* EAGAIN backoff bounds for peer_send() */
+#define BACKOFF_MIN_NS 1000L
+#define BACKOFF_MAX_NS 1000000L
+
+int peer_mgr_init(struct peer_mgr *m, int capacity)
+{
+    memset(m, 0, sizeof(*m));
+    m->peers = calloc((size_t)capacity, sizeof(*m->peers));
+    if (m->peers == NULL) {
+        perror("calloc");
+        return -1;
+    }
+    m->epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (m->epfd == -1) {
+        perror("epoll_create1");
+        free(m->peers);
+        m->peers = NULL;
+        return -1;
+    }
+    m->capacity = capacity;
+    return 0;
+}
+
+void peer_mgr_close(struct peer_mgr *m)
+{
+    for (int i = 0; i < m->count; i++)
+        if (m->peers[i].pidfd >= 0)
+            close(m->peers[i].pidfd);
+    if (m->epfd >= 0)
+        close(m->epfd);
+    free(m->peers);
+    memset(m, 0, sizeof(*m));
+    m->epfd = -1;
+}
+
+int peer_add(struct peer_mgr *m, pid_t pid)
+{
+    if (m->count == m->capacity) {
+        errno = ENOSPC;
+        return -1;
+    }
+
+    int fd = (int)syscall(SYS_pidfd_open, pid, 0);
+    if (fd == -1)
+        return -1;
+
+    int idx = m->count;
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN; /* readable once the process has exited */
+    ev.data.u32 = (uint32_t)idx;
+    if (epoll_ctl(m->epfd, EPOLL_CTL_ADD, fd, &ev) == -1) {
+        int saved = errno;
+        close(fd);
+        errno = saved;
+        return -1;
+    }
+
+    struct peer *p = &m->peers[idx];
+    memset(p, 0, sizeof(*p));
+    p->pid = pid;
+    p->pidfd = fd;
+    m->count++;
+    m->alive++;
+    return idx;
+}
+
+int peer_find(const struct peer_mgr *m, pid_t pid)
+{
+    for (int i = 0; i < m->count; i++)
+        if (m->peers[i].pid == pid && m->peers[i].pidfd >= 0)
+            return i;
+    return -1;
+}
+
+int peer_send(struct peer_mgr *m, int idx, int signo, union sigval value)
+{
+    struct peer *p = &m->peers[idx];
+    if (p->pidfd < 0) {
+        p->failed++;
+        errno = ESRCH;
+        return -1;
+    }
+
+    /* Same siginfo sigqueue() would build; the kernel accepts it because si_code < 0 */
+    siginfo_t info;
+    memset(&info, 0, sizeof(info));
+    info.si_signo = signo;
+    info.si_code = SI_QUEUE;
+    info.si_pid = getpid();
+    info.si_uid = getuid();
+    info.si_value = value;
+
+    long backoff = BACKOFF_MIN_NS;
+    uint64_t waited = 0;
+    while (syscall(SYS_pidfd_send_signal, p->pidfd, signo, &info, 0) == -1) {
+        if (errno == EAGAIN)
+            sm_queue_full(signo);
+        if (errno != EAGAIN || waited >= m->retry_ns) {
+            p->failed++;
+            return -1;
+        }
+        struct timespec pause = { 0, backoff };
+        nanosleep(&pause, NULL);
+        waited += (uint64_t)backoff;
+        if (backoff < BACKOFF_MAX_NS)
+            backoff *= 2;
+    }
+    p->sent++;
+    return 0;
+}
+
+int peer_wait(struct peer_mgr *m, int timeout_ms, const sigset_t *sigmask,
+              peer_exit_fn on_exit, void *arg)
+{
+    struct epoll_event ready[EXIT_BATCH];
+    int n = epoll_pwait(m->epfd, ready, EXIT_BATCH, timeout_ms, sigmask);
+    if (n == -1)
+        return errno == EINTR ? 0 : -1;
+
+    for (int i = 0; i < n; i++) {
+        struct peer *p = &m->peers[ready[i].data.u32];
+        if (p->pidfd < 0)
+            continue;
+        close(p->pidfd); /* also drops it from the epoll set */
+        p->pidfd = -1;
+        m->alive--;
+        if (on_exit != NULL)
+            on_exit(m, p, arg);
+    }
+    return n;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file        : peer_mgr.h
+ * @brief       : pidfd-based peer table: race-free signalling and exit notification.
+ *
+ * Details      :
+ * - Each target PID is opened once with pidfd_open(). Signals go through
+ *   pidfd_send_signal(), so a PID that exits and gets reused by an unrelated
+ *   process can never be hit by mistake: the pidfd keeps naming the original.
+ * - Messages carry an SI_QUEUE siginfo with the payload in si_value, exactly
+ *   what sigqueue() would deliver, so receivers need no changes.
+ * - Every pidfd sits in one epoll set (data = peer index) and becomes
+ *   readable when that process exits, so thousands of peers cost O(1) per
+ *   exit event and nothing is polled.
+ * - peer_wait() can atomically unblock signals while it waits, so a program
+ *   that sleeps in sigsuspend() can wait for "a signal or a peer died" with
+ *   one call.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#ifndef PEER_MGR_H
+#define PEER_MGR_H
+
+#include <signal.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+/** One watched process */
+struct peer
+{
+    pid_t pid;
+    int pidfd;          /* -1 once the peer has exited */
+    uint64_t sent;      /* signals delivered to the peer */
+    uint64_t failed;    /* sends that failed (EAGAIN, ESRCH, ...) */
+};
+
+/** Table of peers plus the epoll set watching them */
+struct peer_mgr
+{
+    int epfd;
+    int count;          /* peers added */
+    int capacity;
+    int alive;          /* peers that have not exited yet */
+    uint64_t retry_ns;  /* how long peer_send() retries EAGAIN (0 = never) */
+    struct peer *peers;
+};
+
+/** Called once for every peer whose exit peer_wait() observed */
+typedef void (*peer_exit_fn)(struct peer_mgr *m, struct peer *p, void *arg);
+
+/**
+ * @brief Create an empty table for up to @p capacity peers.
+ * @return 0 on success, -1 on failure.
+ */
+int peer_mgr_init(struct peer_mgr *m, int capacity);
+
+/** @brief Close every pidfd and the epoll set. */
+void peer_mgr_close(struct peer_mgr *m);
+
+/**
+ * @brief Open and watch @p pid.
+ * @return Peer index, or -1 on failure (ESRCH if no such process, ENOSPC if full).
+ */
+int peer_add(struct peer_mgr *m, pid_t pid);
+
+/** @brief Index of the live peer with @p pid, or -1. */
+int peer_find(const struct peer_mgr *m, pid_t pid);
+
+/**
+ * @brief Queue @p signo with @p value to peer @p idx (sigqueue() semantics).
+ *        A full queue (EAGAIN) is retried with backoff for up to m->retry_ns.
+ * @return 0 on success, -1 on failure (errno set; ESRCH once the peer exited).
+ */
+int peer_send(struct peer_mgr *m, int idx, int signo, union sigval value);
+
+/**
+ * @brief Wait up to @p timeout_ms (-1 = forever) for peers to exit.
+ *
+ * @param sigmask  If not NULL, signal mask to install while waiting
+ *                 (as in sigsuspend()); handlers then interrupt the wait.
+ * @param on_exit  Called for each peer that exited (may be NULL).
+ * @return Number of exits handled, 0 on timeout or signal, -1 on error.
+ */
+int peer_wait(struct peer_mgr *m, int timeout_ms, const sigset_t *sigmask,
+              peer_exit_fn on_exit, void *arg);
+
+#endif /* PEER_MGR_H */
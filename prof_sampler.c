@@ -0,0 +1,231 @@
+/**
+ * @file        : prof_sampler.c
+ * @brief       : In-process SIGPROF sampling profiler that writes folded stacks.
+ *
+ * Details      :
+ * - The frame walk trusts only frame pointers that lie above the interrupted
+ *   stack pointer, are aligned and strictly increase, and it stops after
+ *   PROF_MAX_DEPTH frames or 8 MiB, so a corrupt chain cannot crash the handler.
+ * - Folding sorts the samples so identical stacks are adjacent and then
+ *   prints each distinct stack once with its count.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+/* REG_RIP/REG_RBP in ucontext_t and dladdr() are GNU extensions */
+#define _GNU_SOURCE
+#include "prof_sampler.h"
+
+#include <dlfcn.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <ucontext.h>
+
+/* How far above the stack pointer a frame may be */
+#define PROF_STACK_SPAN (8u << 20)
+
+static struct prof_sample *samples = NULL;
+static size_t capacity = 0;
+static _Atomic size_t taken = 0;
+static struct sigaction previous;
+
+/* Interrupted PC, frame pointer and stack pointer from the ucontext */
+static int context_regs(void *context, uintptr_t *pc, uintptr_t *fp, uintptr_t *sp)
+{
+    ucontext_t *uc = context;
+#if defined(__x86_64__)
+    *pc = (uintptr_t)uc->uc_mcontext.gregs[REG_RIP];
+    *fp = (uintptr_t)uc->uc_mcontext.gregs[REG_RBP];
+    *sp = (uintptr_t)uc->uc_mcontext.gregs[REG_RSP];
+    return 0;
+#elif defined(__aarch64__)
+    *pc = (uintptr_t)uc->uc_mcontext.pc;
+    *fp = (uintptr_t)uc->uc_mcontext.regs[29];
+    *sp = (uintptr_t)uc->uc_mcontext.sp;
+    return 0;
+#else
+    (void)uc;
+    *pc = *fp = *sp = 0;
+    return -1;
+#endif
+}
+
+static void handle_sigprof(int signum, siginfo_t *info, void *context)
+{
+    (void)signum;
+    (void)info;
+
+    size_t slot = atomic_fetch_add_explicit(&taken, 1, memory_order_relaxed);
+    if (slot >= capacity)
+        return; /* buffer full: counted, not stored */
+
+    struct prof_sample *s = &samples[slot];
+    uintptr_t pc, fp, sp;
+    if (context_regs(context, &pc, &fp, &sp) == -1) {
+        s->depth = 0;
+        return;
+    }
+
+    uint32_t depth = 0;
+    s->pc[depth++] = pc;
+
+    /* Frame layout on both targets: [fp] = caller's fp, [fp + 8] = return address */
+    while (depth < PROF_MAX_DEPTH) {
+        if (fp < sp || fp - sp > PROF_STACK_SPAN || (fp & (sizeof(uintptr_t) - 1)) != 0)
+            break;
+        uintptr_t *frame = (uintptr_t *)fp;
+        uintptr_t ret = frame[1];
+        uintptr_t next = frame[0];
+        if (ret == 0)
+            break;
+        s->pc[depth++] = ret;
+        if (next <= fp)
+            break;
+        fp = next;
+    }
+    s->depth = depth;
+}
+
+int prof_start(unsigned hz, size_t max_samples)
+{
+    if (hz == 0 || max_samples == 0)
+        return -1;
+
+    samples = calloc(max_samples, sizeof(*samples));
+    if (samples == NULL) {
+        perror("calloc");
+        return -1;
+    }
+    capacity = max_samples;
+    atomic_store(&taken, 0);
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_sigaction = handle_sigprof;
+    sa.sa_flags = SA_SIGINFO | SA_RESTART;
+    if (sigaction(SIGPROF, &sa, &previous) == -1) {
+        perror("sigaction");
+        free(samples);
+        samples = NULL;
+        return -1;
+    }
+
+    struct itimerval it;
+    it.it_interval.tv_sec = 0;
+    it.it_interval.tv_usec = hz >= 1000000 ? 1 : (suseconds_t)(1000000 / hz);
+    it.it_value = it.it_interval;
+    if (setitimer(ITIMER_PROF, &it, NULL) == -1) {
+        perror("setitimer");
+        sigaction(SIGPROF, &previous, NULL);
+        free(samples);
+        samples = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+size_t prof_samples(void)
+{
+    return atomic_load_explicit(&taken, memory_order_relaxed);
+}
+
+/* Order samples by their stack, root first, so equal stacks are adjacent */
+static int compare_samples(const void *a, const void *b)
+{
+    const struct prof_sample *x = a, *y = b;
+    uint32_t i = x->depth, j = y->depth;
+    while (i > 0 && j > 0) {
+        uintptr_t px = x->pc[--i], py = y->pc[--j];
+        if (px != py)
+            return px < py ? -1 : 1;
+    }
+    return (i > 0) - (j > 0);
+}
+
+/*
+ * Fold a raw frame address to the start of its symbol, so every sample in the
+ * same function compares equal. Return addresses point after the call, so the
+ * call itself is looked up. Unnamed code keeps its (adjusted) address.
+ */
+static uintptr_t canonical_pc(uintptr_t pc, int is_return)
+{
+    Dl_info dl;
+    uintptr_t lookup = is_return ? pc - 1 : pc;
+
+    if (dladdr((void *)lookup, &dl) != 0 && dl.dli_sname != NULL && dl.dli_saddr != NULL)
+        return (uintptr_t)dl.dli_saddr;
+    return lookup;
+}
+
+/* Print one frame: symbol name, or module+offset, or raw address */
+static void print_frame(FILE *out, uintptr_t pc)
+{
+    Dl_info dl;
+
+    if (dladdr((void *)pc, &dl) == 0) {
+        fprintf(out, "0x%lx", (unsigned long)pc);
+    } else if (dl.dli_sname != NULL) {
+        fputs(dl.dli_sname, out);
+    } else {
+        const char *base = dl.dli_fname ? strrchr(dl.dli_fname, '/') : NULL;
+        fprintf(out, "%s+0x%lx", base ? base + 1 : (dl.dli_fname ? dl.dli_fname : "?"),
+                (unsigned long)(pc - (uintptr_t)dl.dli_fbase));
+    }
+}
+
+long prof_stop(const char *path)
+{
+    struct itimerval off;
+    memset(&off, 0, sizeof(off));
+    setitimer(ITIMER_PROF, &off, NULL);
+
+    /* A tick may still be pending; never let it hit SIGPROF's default (terminate) */
+    if (!(previous.sa_flags & SA_SIGINFO) && previous.sa_handler == SIG_DFL)
+        previous.sa_handler = SIG_IGN;
+    sigaction(SIGPROF, &previous, NULL);
+
+    size_t total = prof_samples();
+    size_t stored = total < capacity ? total : capacity;
+
+    if (path != NULL && samples != NULL) {
+        FILE *out = strcmp(path, "-") == 0 ? stdout : fopen(path, "w");
+        if (out == NULL) {
+            perror("fopen");
+        } else {
+            for (size_t i = 0; i < stored; i++)
+                for (uint32_t d = 0; d < samples[i].depth; d++)
+                    samples[i].pc[d] = canonical_pc(samples[i].pc[d], d != 0);
+
+            qsort(samples, stored, sizeof(*samples), compare_samples);
+            for (size_t i = 0; i < stored;) {
+                size_t j = i + 1;
+                while (j < stored && compare_samples(&samples[i], &samples[j]) == 0)
+                    j++;
+
+                const struct prof_sample *s = &samples[i];
+                for (uint32_t d = s->depth; d > 0; d--) {
+                    print_frame(out, s->pc[d - 1]);
+                    if (d > 1)
+                        fputc(';', out);
+                }
+                fprintf(out, " %zu\n", j - i);
+                i = j;
+            }
+            if (out != stdout)
+                fclose(out);
+        }
+    }
+
+    free(samples);
+    samples = NULL;
+    capacity = 0;
+    return (long)total;
+}
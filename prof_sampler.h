@@ -0,0 +1,55 @@
+/**
+ * @file        : prof_sampler.h
+ * @brief       : In-process SIGPROF sampling profiler that writes folded stacks.
+ *
+ * Details      :
+ * - setitimer(ITIMER_PROF) delivers SIGPROF at a configurable frequency,
+ *   counting CPU time consumed by the whole process.
+ * - The SA_SIGINFO handler takes the interrupted PC from the ucontext_t
+ *   argument and walks the frame-pointer chain for a bounded number of
+ *   return addresses. Each sample goes into a preallocated buffer slot
+ *   claimed with one atomic fetch-add, so the handler never locks or allocates.
+ * - prof_stop() symbolizes the samples with dladdr() and writes
+ *   "outer;inner;leaf count" lines, the input format of flamegraph.pl.
+ * - Build the profiled program with -fno-omit-frame-pointer (and -rdynamic
+ *   for symbol names of functions in the executable).
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#ifndef PROF_SAMPLER_H
+#define PROF_SAMPLER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Frames kept per sample (PC included) */
+#define PROF_MAX_DEPTH 32
+
+struct prof_sample
+{
+    uint32_t depth;
+    uintptr_t pc[PROF_MAX_DEPTH];   /* leaf first */
+};
+
+/**
+ * @brief Allocate room for @p max_samples and start sampling at @p hz.
+ * @return 0 on success, -1 on failure.
+ */
+int prof_start(unsigned hz, size_t max_samples);
+
+/**
+ * @brief Stop sampling and write folded stacks to @p path ("-" for stdout,
+ *        NULL to skip writing). Frees the sample buffer.
+ * @return Number of samples taken, or -1 on failure.
+ */
+long prof_stop(const char *path);
+
+/** @brief Samples taken so far (including ones dropped for lack of space). */
+size_t prof_samples(void);
+
+#endif /* PROF_SAMPLER_H */
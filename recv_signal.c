@@ -6,6 +6,39 @@
  * - Uses SA_SIGINFO to access the siginfo_t struct (si_value.sival_int).
  * - Waits indefinitely for SIGUSR1.
  * - Prints the integer value sent via sigqueue() by the sender.
+ * - Optional signalfd mode (-f): the signals are blocked with
+ *   pthread_sigmask() and drained in batches from a signalfd inside an
+ *   epoll loop, so no work is done in signal context.
+ * - Optional real-time channels (-r): also listens on every channel signal,
+ *   treats sival_int as a per-channel sequence number and counts gaps.
+ *   SIGINT prints per-channel totals and RLIMIT_SIGPENDING headroom.
+ * - Optional shared-memory ring (-s name): bulk payload bytes arrive through
+ *   a shm_open()/mmap() ring and SIGUSR1 is only a doorbell, sent when the
+ *   ring goes from empty to non-empty. SIGUSR2 marks the end of the stream.
+ * - Optional worker pool (-w N): N threads each block in sigtimedwait() on
+ *   the shared receive mask, optionally pinned to CPUs (-p), with per-worker
+ *   counters. Per-thread and aggregate messages/s are printed every second.
+ *   Worker i owns the channels c with c % N == i; messages taken by another
+ *   worker are counted as off-shard.
+ * - Optional routing table (-T name, with -w): each worker publishes its
+ *   thread ID for its shard (sig_router.c), so send_signal -T can queue
+ *   every channel directly on the thread that owns it.
+ * - Optional credit return (-a N): in handler and signalfd modes, every
+ *   sender that announced a window (send_signal -W) is acked with
+ *   FLOW_ACK_SIGNAL after each N messages (at most half its window). An
+ *   ack refused with EAGAIN is resent before every wait until it gets through.
+ * - Optional trace (-t file): every received signal is appended as a
+ *   fixed-size binary record to an mmap'd file (sig_trace.c) for sig_replay.
+ * - Messages with a structured payload (payload.h, sent by send_signal's
+ *   stream and load modes) are decoded: their sequence number drives the
+ *   gap/reorder accounting (for SIGUSR1 too, which shows merged signals),
+ *   and their embedded send time gives the one-way latency from sigqueue()
+ *   to the moment this receiver processes the message. Plain sival_int
+ *   values are still accepted and printed as before.
+ * - Every mode exports per-signal counts, handling times (handler, or
+ *   consume() for signalfd/workers/ring) and handler-queue drops in a
+ *   shared metrics page (sig_metrics.h); metrics_dump reads it while the
+ *   receiver runs at full rate.
  *
  * Course       : CPE 2600 – Systems Programming
  * Section      : 112
@@ -13,51 +46,706 @@
  * Modified by  : Jesse Rost <rostj@msoe.edu>
  * Date         : 11/10/25
  *
- * Compile      : gcc -Wall -Wextra recv_signal.c -o recv_signal
- * Usage        : ./recv_signal
+ * Compile      : make recv_signal
+ * Usage        : ./recv_signal [-f] [-r] [-q] [-a every] [-t file] [-s name [-z bytes]]
+ *                               [-w threads [-p] [-T name]]
+ *                  -f  signalfd/epoll receive loop
+ *                  -r  receive on all real-time channels
+ *                  -q  quiet: do not print every message
+ *                  -s  receive bulk data through shared-memory ring "name"
+ *                  -z  ring capacity in bytes (default 1 MiB)
+ *                  -w  receive with a pool of sigtimedwait() worker threads
+ *                  -p  pin worker i to CPU i (modulo online CPUs)
+ *                  -T  publish a thread routing table "name" for the workers
+ *                  -a  return flow-control credit every N messages
+ *                  -t  record every received signal to a binary trace file
  *
  * Algorithm
- *  - Configure struct sigaction with SA_SIGINFO.
- *  - Register handler for SIGUSR1.
- *  - Pause forever, printing sival_int when received.
+ *  - Handler mode (default):
+ *    - Register consume() for SIGUSR1 (and every channel signal with -r)
+ *      in the signal runtime's dispatch table (sigrt.h).
+ *    - Its handler only pushes the siginfo into a lock-free event queue.
+ *    - Sleep in sigsuspend() until SIGINT, dispatching each drained batch.
+ *  - signalfd mode (-f):
+ *    - Block the signals so they stay pending instead of running a handler.
+ *    - Create a signalfd for that mask and add it to an epoll set.
+ *    - On each wakeup read as many signalfd_siginfo records as are queued
+ *      and print the whole batch with a single flush.
+ *  - Ring mode (-s):
+ *    - Create the ring, block SIGUSR1/SIGUSR2 and wait in sigwaitinfo().
+ *    - On every doorbell drain the ring until it is empty.
+ *    - On SIGUSR2 drain up to the final tail and report bytes and MB/s.
+ *  - Worker pool mode (-w):
+ *    - Block the receive mask in every thread before creating the workers.
+ *    - Each worker loops in sigtimedwait() and bumps its own counter.
+ *    - Main waits for SIGINT with a one-second timeout and prints rates.
  */
 
 #define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
 #include <signal.h>
 #include <string.h>
 #include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/select.h>
+#include <sys/signalfd.h>
 
-/* Handler for SIGUSR1 using siginfo_t */
-void handle_sigusr1(int signum, siginfo_t *info, void *context)
+#include "rt_channel.h"
+#include "shm_ring.h"
+#include "latency_hist.h"
+#include "sigrt.h"
+#include "cpu_affinity.h"
+#include "flow_ctl.h"
+#include "sig_trace.h"
+#include "sig_router.h"
+#include "payload.h"
+#include "sig_metrics.h"
+
+/* Number of siginfo records pulled out of the signalfd per read() */
+#define SIGFD_BATCH 64
+
+/* Default shared-memory ring capacity and consumer copy size */
+#define RING_DEFAULT_BYTES (1u << 20)
+#define RING_CHUNK         65536
+
+/* Worker pool limits and how often idle workers re-check for shutdown */
+#define MAX_WORKERS        256
+#define WORKER_TIMEOUT_NS  100000000L
+
+/* Command-line options */
+static int use_channels = 0;
+static int quiet = 0;
+static int use_credit = 0;
+
+/* Credit owed to flow-controlled senders (-a) */
+static struct flow_receiver credit;
+
+/* Binary trace of every received signal (-t); no-op when not created */
+static struct sig_trace trace;
+
+/* Receive statistics: SIGUSR1 count and one stream per real-time channel */
+static uint64_t usr1_received = 0;
+static struct rt_stream usr1_stream;   /* numbered SIGUSR1 messages only */
+static struct rt_stream streams[RT_MAX_CHANNELS];
+
+/* Send-to-consume time of every message with a structured payload */
+static struct latency_hist one_way;
+
+/* Set by SIGINT in handler mode */
+static volatile sig_atomic_t stop = 0;
+
+/* Handler for SIGINT: leave the receive loop and print the summary.
+   Installed directly rather than through sigrt, so it is never traced */
+static void handle_stop(int signum, siginfo_t *info, void *context)
 {
-    (void)signum;
+    (void)info;
     (void)context;
-    printf("Received SIGUSR1 with value: %d\n", info->si_value.sival_int);
+    uint64_t start = mono_ns();
+    stop = 1;
+    sm_handled(signum, start);
+}
+
+/* Signals this receiver listens on (SIGINT excluded) */
+static void receive_mask(sigset_t *set)
+{
+    sigemptyset(set);
+    sigaddset(set, SIGUSR1);
+    if (use_channels) {
+        for (int ch = 0; ch < rt_channel_count(); ch++)
+            sigaddset(set, rt_channel_signo(ch));
+    } else {
+        sigaddset(set, SIGRTMIN);
+    }
+    /* Always caught, so a flow-controlled sender's hello cannot kill us */
+    sigaddset(set, FLOW_ACK_SIGNAL);
+}
+
+/* Account for and print one received signal (main-thread context only);
+   @p raw is the whole 64-bit si_value */
+static void consume(int signo, uint64_t raw, pid_t sender)
+{
+    int ch = rt_channel_of(signo);
+    int value = (int)(uint32_t)raw;   /* sival_int */
+    struct payload p;
+    int structured = payload_decode(raw, &p) == 0;
+    double age_us = 0;
+    if (structured) {
+        uint64_t age = payload_age_ns(&p, mono_ns());
+        hist_record(&one_way, age);
+        age_us = age / 1e3;
+    }
+
+    if (signo == FLOW_ACK_SIGNAL) {
+        /* A flow-controlled sender announcing its window */
+        if (use_credit)
+            flow_hello(&credit, sender, (uint32_t)value);
+        else
+            printf("PID %d wants credit; run with -a to return it\n", sender);
+        return;
+    }
+    if (use_credit)
+        flow_consumed(&credit, sender);
+
+    if (signo == SIGUSR1 && structured) {
+        /* Standard signals merge while pending; the sequence shows how many */
+        usr1_received++;
+        uint32_t skipped = rt_stream_accept(&usr1_stream, p.seq);
+        if (skipped != 0)
+            printf("SIGUSR1: %u merged before seq %u\n", skipped, p.seq);
+        else if (!quiet)
+            printf("Received SIGUSR1 seq %u (one-way %.2f us)\n", p.seq, age_us);
+    } else if (signo == SIGUSR1) {
+        usr1_received++;
+        if (!quiet)
+            printf("Received SIGUSR1 with value: %d\n", value);
+    } else if (use_channels && ch >= 0) {
+        uint32_t seq = structured ? p.seq : (uint32_t)value;
+        uint32_t skipped = rt_stream_accept(&streams[ch], seq);
+        if (skipped != 0)
+            printf("Channel %d: gap of %u before seq %u\n", ch, skipped, seq);
+        else if (!quiet && structured)
+            printf("Received channel %d seq %u (one-way %.2f us)\n", ch, seq, age_us);
+        else if (!quiet)
+            printf("Received channel %d seq %u\n", ch, seq);
+    } else if (!quiet) {
+        if (structured)
+            printf("Received SIGRTMIN %s seq %u (one-way %.2f us)\n", payload_op_name(p.op), p.seq, age_us);
+        else
+            printf("Received SIGRTMIN with value: %d\n", value);
+    }
+}
+
+/* Per-channel totals printed on exit */
+static void print_summary(void)
+{
+    printf("\nSIGUSR1 received: %llu\n", (unsigned long long)usr1_received);
+    if (usr1_stream.received != 0)
+        printf("SIGUSR1 numbered: %llu, merged away %llu, reordered %llu\n",
+               (unsigned long long)usr1_stream.received, (unsigned long long)usr1_stream.missing,
+               (unsigned long long)usr1_stream.reordered);
+    if (sigrt_dropped() != 0)
+        printf("Events dropped (handler queue full): %llu\n",
+               (unsigned long long)sigrt_dropped());
+    for (int ch = 0; ch < rt_channel_count(); ch++) {
+        const struct rt_stream *s = &streams[ch];
+        if (s->received == 0)
+            continue;
+        printf("Channel %2d: received %llu, gaps %llu (missing %llu), reordered %llu\n",
+               ch, (unsigned long long)s->received, (unsigned long long)s->gaps,
+               (unsigned long long)s->missing, (unsigned long long)s->reordered);
+    }
+    if (use_credit)
+        printf("Credit acks sent: %llu (%llu failed)\n", (unsigned long long)credit.acks_sent,
+               (unsigned long long)credit.acks_failed);
+    if (one_way.count != 0)
+        hist_print(&one_way, "One-way latency (send -> consume)", stdout);
+    rt_print_headroom(stdout);
+}
+
+/* Dispatch-table entry for every receive signal: the runtime already
+   queued it, consume() does the accounting */
+static void consume_event(const struct sig_event *ev, const struct payload *p, void *state)
+{
+    (void)p;
+    (void)state;
+    consume(ev->signo, payload_raw(ev->value), ev->pid);
+}
+
+/**
+ * @brief Classic receive loop: one handler invocation per signal.
+ *        Handlers queue events; the main loop dispatches and prints them.
+ */
+static int run_handler_mode(void)
+{
+    sigset_t receive, blocked, waitmask;
+    receive_mask(&receive);
+    for (int signo = 1; signo < SIGRT_SIGNALS; signo++) {
+        if (sigismember(&receive, signo) == 1)
+            sigrt_on(signo, SIGRT_ANY_OP, consume_event, NULL);
+    }
+    sigrt_trace(&trace);
+
+    /* Keep the signals blocked except while sleeping in sigsuspend();
+       handlers never nest, so a burst cannot outrun the queue in one wakeup */
+    if (sigrt_start(&waitmask) == -1)
+        return 1;
+    blocked = receive;
+    sigaddset(&blocked, SIGINT);
+    sigset_t stop_mask;
+    sigemptyset(&stop_mask);
+    sigaddset(&stop_mask, SIGINT);
+    sigprocmask(SIG_BLOCK, &stop_mask, NULL);
+    if (sigrt_action(SIGINT, handle_stop, &blocked) == -1)
+        return 1;
+
+    printf("Receiver process PID: %d\n", getpid());
+    if (use_channels) {
+        printf("Waiting for SIGUSR1 and %d real-time channels...\n", rt_channel_count());
+        rt_print_headroom(stdout);
+    } else {
+        printf("Waiting for SIGUSR1...\n");
+    }
+
+    fflush(stdout);
+
+    /* Wait for incoming signals until interrupted, printing each batch */
+    while (!stop)
+    {
+        /* An ack that failed is retried every FLOW_RETRY_MS until it goes
+           through; otherwise sleep until the next signal */
+        if (use_credit && flow_flush(&credit) > 0) {
+            struct timespec retry = { 0, FLOW_RETRY_MS * 1000000L };
+            pselect(0, NULL, NULL, NULL, &retry, &waitmask);
+        } else {
+            sigsuspend(&waitmask);
+        }
+        sigrt_dispatch();
+        fflush(stdout);
+    }
+
+    print_summary();
+    return 0;
 }
 
-int main(void)
+/**
+ * @brief Event-loop receive: signals are read from a signalfd in batches.
+ */
+static int run_signalfd_mode(void)
 {
-    struct sigaction sa;
-    memset(&sa, 0, sizeof(sa));
+    sigset_t mask;
+    receive_mask(&mask);
+    sigaddset(&mask, SIGINT);
+
+    /* Blocked signals stay pending and become readable on the signalfd */
+    int err = pthread_sigmask(SIG_BLOCK, &mask, NULL);
+    if (err != 0)
+    {
+        fprintf(stderr, "pthread_sigmask: %s\n", strerror(err));
+        return 1;
+    }
+
+    int sfd = signalfd(-1, &mask, SFD_CLOEXEC | SFD_NONBLOCK);
+    if (sfd == -1)
+    {
+        perror("signalfd");
+        return 1;
+    }
 
-    sa.sa_sigaction = handle_sigusr1;
-    sa.sa_flags = SA_SIGINFO; /* Required for accessing si_value */
+    int epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (epfd == -1)
+    {
+        perror("epoll_create1");
+        close(sfd);
+        return 1;
+    }
 
-    if (sigaction(SIGUSR1, &sa, NULL) == -1)
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = sfd;
+    if (epoll_ctl(epfd, EPOLL_CTL_ADD, sfd, &ev) == -1)
     {
-        perror("sigaction");
+        perror("epoll_ctl");
+        close(epfd);
+        close(sfd);
         return 1;
     }
 
     printf("Receiver process PID: %d\n", getpid());
-    printf("Waiting for SIGUSR1...\n");
+    if (use_channels) {
+        printf("Waiting for SIGUSR1 and %d real-time channels on signalfd...\n",
+               rt_channel_count());
+        rt_print_headroom(stdout);
+    } else {
+        printf("Waiting for SIGUSR1/SIGRTMIN on signalfd...\n");
+    }
+    fflush(stdout);
+
+    struct signalfd_siginfo batch[SIGFD_BATCH];
+    int status = 0;
+    while (!stop)
+    {
+        struct epoll_event ready;
+        int owed = use_credit ? flow_flush(&credit) : 0;
+        int n = epoll_wait(epfd, &ready, 1, owed > 0 ? FLOW_RETRY_MS : -1);
+        if (n == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            perror("epoll_wait");
+            status = 1;
+            break;
+        }
+
+        /* Drain everything queued before going back to sleep */
+        while (1)
+        {
+            ssize_t got = read(sfd, batch, sizeof(batch));
+            if (got == -1)
+            {
+                if (errno != EAGAIN && errno != EINTR)
+                    perror("read");
+                break;
+            }
+
+            size_t count = (size_t)got / sizeof(batch[0]);
+            for (size_t i = 0; i < count; i++)
+            {
+                if (batch[i].ssi_signo == (uint32_t)SIGINT)
+                    stop = 1;
+                else
+                {
+                    uint64_t start = mono_ns();
+                    st_append(&trace, (int)batch[i].ssi_signo, (pid_t)batch[i].ssi_pid,
+                              batch[i].ssi_code, batch[i].ssi_ptr);
+                    consume((int)batch[i].ssi_signo, batch[i].ssi_ptr, (pid_t)batch[i].ssi_pid);
+                    sm_handled((int)batch[i].ssi_signo, start);
+                }
+            }
+            fflush(stdout);
+
+            if (count < SIGFD_BATCH)
+                break;
+        }
+    }
+
+    print_summary();
+    close(epfd);
+    close(sfd);
+    return status;
+}
+
+/**
+ * @brief Bulk receive: drain a shared-memory ring whenever the doorbell rings.
+ */
+static int run_ring_mode(const char *name, uint32_t capacity)
+{
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGUSR1);
+    sigaddset(&mask, SIGUSR2);
+    sigaddset(&mask, SIGINT);
+
+    /* Block before the ring exists so no doorbell can be missed */
+    if (sigprocmask(SIG_BLOCK, &mask, NULL) == -1)
+    {
+        perror("sigprocmask");
+        return 1;
+    }
+
+    struct shm_ring ring;
+    if (shm_ring_create(&ring, name, capacity) == -1)
+        return 1;
+
+    printf("Receiver process PID: %d\n", getpid());
+    printf("Waiting for data on ring %s (%u bytes)...\n", name, ring.hdr->capacity);
+    fflush(stdout);
+
+    static unsigned char chunk[RING_CHUNK];
+    uint64_t bytes = 0;
+    uint64_t doorbells = 0;
+    uint64_t start = 0;
+    uint32_t checksum = 2166136261u; /* FNV-1a over the whole stream */
 
-    /* Wait indefinitely for incoming signals */
     while (1)
     {
-        pause();
+        siginfo_t info;
+        int sig = sigwaitinfo(&mask, &info);
+        if (sig == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            perror("sigwaitinfo");
+            break;
+        }
+        if (sig == SIGINT)
+            break;
+        uint64_t handle_start = mono_ns();
+        st_record(&trace, sig, &info);
+        if (sig == SIGUSR1)
+        {
+            doorbells++;
+            if (start == 0)
+                start = mono_ns();
+        }
+
+        size_t got;
+        while ((got = shm_ring_read(&ring, chunk, sizeof(chunk))) > 0)
+        {
+            for (size_t i = 0; i < got; i++)
+                checksum = (checksum ^ chunk[i]) * 16777619u;
+            bytes += got;
+        }
+        sm_handled(sig, handle_start);
+
+        /* SIGUSR2 carries the final tail; everything before it is now consumed */
+        if (sig == SIGUSR2)
+            break;
     }
 
+    double secs = start != 0 ? (mono_ns() - start) / 1e9 : 0.0;
+    printf("Received %llu bytes via %llu doorbells in %.3f s (%.1f MB/s), checksum %08x\n",
+           (unsigned long long)bytes, (unsigned long long)doorbells, secs,
+           secs > 0 ? bytes / secs / 1e6 : 0.0, checksum);
+
+    shm_ring_close(&ring, name);
     return 0;
 }
+
+/** Per-worker state, padded so counters never share a cache line */
+struct worker
+{
+    _Alignas(64) _Atomic uint64_t received;
+    uint64_t off_shard; /* messages for another worker's channels */
+    struct latency_hist one_way;    /* structured payloads only */
+    pthread_t thread;
+    int index;
+    int cpu;            /* -1 when not pinned */
+    uint64_t last;      /* count at the previous report (main thread only) */
+};
+
+static struct worker workers[MAX_WORKERS];
+static _Atomic int workers_stop = 0;
+static sigset_t worker_mask;
+static int nshards;
+
+/* Thread routing table (-T); workers register their TIDs in it */
+static struct sig_router router;
+static int use_router = 0;
+
+/* Worker thread: take process-directed signals off the shared mask */
+static void *worker_main(void *arg)
+{
+    struct worker *w = arg;
+    if (use_router)
+        router_register(&router, w->index, w->cpu); /* also pins */
+    else if (w->cpu >= 0)
+        pin_thread_to_cpu(w->cpu);
+
+    struct timespec timeout = { 0, WORKER_TIMEOUT_NS };
+    siginfo_t info;
+    while (!atomic_load_explicit(&workers_stop, memory_order_relaxed))
+    {
+        int sig = sigtimedwait(&worker_mask, &info, &timeout);
+        if (sig > 0)
+        {
+            uint64_t start = mono_ns();
+            st_record(&trace, sig, &info);
+            struct payload p;
+            if (payload_decode(payload_raw(info.si_value), &p) == 0)
+                hist_record(&w->one_way, payload_age_ns(&p, mono_ns()));
+            int ch = rt_channel_of(sig);
+            if ((ch < 0 ? 0 : ch) % nshards != w->index)
+                w->off_shard++;
+            atomic_fetch_add_explicit(&w->received, 1, memory_order_relaxed);
+            sm_handled(sig, start);
+        }
+    }
+    if (use_router)
+        router_unregister(&router, w->index);
+    return NULL;
+}
+
+/**
+ * @brief Receive with a pool of threads blocked in sigtimedwait().
+ */
+static int run_worker_mode(int nworkers, int pin, const char *route_name)
+{
+    receive_mask(&worker_mask);
+    nshards = nworkers;
+    if (route_name != NULL)
+    {
+        if (router_create(&router, route_name, nworkers, ROUTE_BY_CHANNEL) == -1)
+            return 1;
+        use_router = 1;
+    }
+
+    /* Everything blocked in main first so every worker inherits the mask */
+    sigset_t blocked;
+    receive_mask(&blocked);
+    sigaddset(&blocked, SIGINT);
+    int err = pthread_sigmask(SIG_BLOCK, &blocked, NULL);
+    if (err != 0)
+    {
+        fprintf(stderr, "pthread_sigmask: %s\n", strerror(err));
+        return 1;
+    }
+
+    int started = 0;
+    for (int i = 0; i < nworkers; i++)
+    {
+        workers[i].index = i;
+        workers[i].cpu = pin ? i % online_cpus() : -1;
+        hist_init(&workers[i].one_way);
+        err = pthread_create(&workers[i].thread, NULL, worker_main, &workers[i]);
+        if (err != 0)
+        {
+            fprintf(stderr, "pthread_create: %s\n", strerror(err));
+            break;
+        }
+        started++;
+    }
+
+    printf("Receiver process PID: %d\n", getpid());
+    printf("Waiting for signals with %d worker thread(s)%s%s%s...\n",
+           started, pin ? " pinned to CPUs" : "",
+           use_router ? ", routing table " : "", use_router ? route_name : "");
+    fflush(stdout);
+
+    sigset_t stop_mask;
+    sigemptyset(&stop_mask);
+    sigaddset(&stop_mask, SIGINT);
+    struct timespec tick = { 1, 0 };
+    uint64_t start = mono_ns();
+    uint64_t prev = start;
+
+    while (started > 0)
+    {
+        int sig = sigtimedwait(&stop_mask, NULL, &tick);
+        if (sig == -1 && errno == EINTR)
+            continue; /* a metrics snapshot, not the next tick */
+        uint64_t now = mono_ns();
+        double secs = (now - prev) / 1e9;
+        prev = now;
+
+        uint64_t total = 0;
+        printf("[%6.1fs]", (now - start) / 1e9);
+        for (int i = 0; i < started; i++)
+        {
+            uint64_t c = atomic_load_explicit(&workers[i].received, memory_order_relaxed);
+            printf(" w%d=%.0f", i, (c - workers[i].last) / secs);
+            total += c - workers[i].last;
+            workers[i].last = c;
+        }
+        printf(" | total %.0f msg/s\n", total / secs);
+        fflush(stdout);
+
+        if (sig == SIGINT)
+            break;
+    }
+
+    atomic_store(&workers_stop, 1);
+    for (int i = 0; i < started; i++)
+        pthread_join(workers[i].thread, NULL);
+
+    double secs = (mono_ns() - start) / 1e9;
+    uint64_t total = 0;
+    printf("\n");
+    for (int i = 0; i < started; i++)
+    {
+        uint64_t c = atomic_load(&workers[i].received);
+        total += c;
+        printf("Worker %3d (cpu %2d): %llu messages, %.0f msg/s, %llu off-shard\n", i,
+               workers[i].cpu, (unsigned long long)c, c / secs,
+               (unsigned long long)workers[i].off_shard);
+    }
+    printf("Aggregate: %llu messages in %.1f s, %.0f msg/s\n",
+           (unsigned long long)total, secs, total / secs);
+    for (int i = 0; i < started; i++)
+        hist_merge(&one_way, &workers[i].one_way);
+    if (one_way.count != 0)
+        hist_print(&one_way, "One-way latency (send -> worker)", stdout);
+    rt_print_headroom(stdout);
+    if (use_router)
+        router_close(&router, route_name);
+    return started > 0 ? 0 : 1;
+}
+
+int main(int argc, char *argv[])
+{
+    int use_signalfd = 0;
+    const char *ring_name = NULL;
+    uint32_t ring_bytes = RING_DEFAULT_BYTES;
+    int nworkers = 0;
+    int pin = 0;
+    const char *trace_path = NULL;
+    const char *route_name = NULL;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "frqa:t:s:z:w:pT:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'a':
+            use_credit = 1;
+            flow_receiver_init(&credit, (uint32_t)strtoul(optarg, NULL, 0));
+            break;
+        case 't':
+            trace_path = optarg;
+            break;
+        case 'f':
+            use_signalfd = 1;
+            break;
+        case 'r':
+            use_channels = 1;
+            break;
+        case 'q':
+            quiet = 1;
+            break;
+        case 's':
+            ring_name = optarg;
+            break;
+        case 'z':
+            ring_bytes = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'w':
+            nworkers = atoi(optarg);
+            break;
+        case 'p':
+            pin = 1;
+            break;
+        case 'T':
+            route_name = optarg;
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-f] [-r] [-q] [-a every] [-t file] [-s name [-z bytes]] [-w threads [-p] [-T name]]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+
+    if (use_credit && (nworkers > 0 || ring_name != NULL))
+    {
+        fprintf(stderr, "-a works with the handler and signalfd receive modes only\n");
+        return 1;
+    }
+
+    if (route_name != NULL && nworkers == 0)
+    {
+        fprintf(stderr, "-T routes to worker threads; use it with -w\n");
+        return 1;
+    }
+
+    if (trace_path != NULL && st_create(&trace, trace_path, 0) == -1)
+        return 1;
+
+    sigrt_init("recv_signal");
+    hist_init(&one_way);
+    int status;
+    if (nworkers > 0)
+    {
+        if (nworkers > MAX_WORKERS)
+            nworkers = MAX_WORKERS;
+        status = run_worker_mode(nworkers, pin, route_name);
+    }
+    else if (ring_name != NULL)
+        status = run_ring_mode(ring_name, ring_bytes);
+    else
+        status = use_signalfd ? run_signalfd_mode() : run_handler_mode();
+
+    if (trace_path != NULL)
+    {
+        printf("Trace: %llu signals written to %s", (unsigned long long)st_count(&trace), trace_path);
+        if (st_dropped(&trace) != 0)
+            printf(" (%llu dropped, file full)", (unsigned long long)st_dropped(&trace));
+        printf("\n");
+        st_close(&trace);
+    }
+    return status;
+}
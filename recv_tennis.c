@@ -7,6 +7,16 @@
  * - When received, prints sender PID and volley count.
  * - Waits 1–2 seconds, then sends the signal back with an incremented volley count.
  * - Ends the game cleanly when volley reaches 10.
+ * - Watches the opponent through a pidfd, so the game ends at once if the
+ *   opponent process dies instead of waiting for a ball that never comes.
+ * - Optional trace (-t file): every ball and end signal is appended as a
+ *   binary record to an mmap'd file that sig_replay can re-send later.
+ * - -r name waits for a server started with the same name (rendezvous.c)
+ *   instead of printing a PID to paste; -f skips the pacing delays and
+ *   -n sets the game length.
+ * - Every ball is a structured payload (payload.h) with the volley count and
+ *   the time it was hit, so each side prints how long the ball was in
+ *   flight and notices a volley that is not the one after its last hit.
  *
  * Course       : CPE 2600 – Systems Programming
  * Section      : 112
@@ -14,125 +24,262 @@
  * Author       : rostj@msoe.edu <Jesse Rost>
  * Date         : 11/10/25
  *
- * Compile      : gcc -Wall -Wextra recv_tennis.c -o recv_tennis
- * Usage        : ./recv_tennis
+ * Compile      : make recv_tennis
+ * Usage        : ./recv_tennis [-f] [-n volleys] [-r name] [-t trace_file]
  *
  * Algorithm
- *  1. Install a signal handler for SIGUSR1 using sigaction().
- *  2. Wait for the first volley (serve) from the opponent.
+ *  1. Register play_ball() for SIGUSR1 with the signal runtime (sigrt.h);
+ *     its handler only queues the ball, the main loop plays it.
+ *  2. Wait for the first volley (serve) from the opponent; with -r, first
+ *     take the server's handshake so its pidfd is open before the serve.
  *  3. When received, extract sender PID and volley count.
- *  4. Delay for 1–2 seconds, then increment the volley count.
+ *  4. Delay for 1–2 seconds (unless -f), then increment the volley count.
  *  5. Send SIGUSR1 back to the opponent with the updated value.
- *  6. Continue until volley count reaches 10, then exit cleanly.
+ *  6. Continue until volley count reaches 10 (-n), then exit cleanly.
+ *  7. Wait in epoll_pwait() on the opponent's pidfd with the signals
+ *     unblocked, so either a ball or the opponent's exit wakes us up.
  */
 
 #define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdlib.h>
 #include <signal.h>
-#include <string.h>
 #include <unistd.h>
 #include <time.h>
+#include <errno.h>
+
+#include "sigrt.h"
+#include "peer_mgr.h"
+#include "sig_trace.h"
+#include "rendezvous.h"
+#include "payload.h"
+#include "latency_hist.h"
+
+// how long to keep retrying a ball the opponent has no room to queue (EAGAIN)
+#define BALL_RETRY_NS 1000000000ULL
 
 // stores the pid of the other player
 static pid_t opponent_pid = 0;
 
-/**
- * @brief Graceful exit handler for SIGUSR2.
- *        Prints message and exits cleanly instead of being killed.
- */
-void handle_game_over(int signum)
+// game length (-n) and whether to skip the 1–2 second pacing (-f)
+static int max_volleys = 10;
+static int fast = 0;
+
+// the last volley we hit, so the next one back can be checked
+static int last_hit = 0;
+
+// the opponent opened as a pidfd: sends can never hit a recycled PID,
+// and the pidfd turns readable the moment the opponent exits
+static struct peer_mgr peers;
+static int opponent = -1;
+static int opponent_gone = 0;
+
+// binary record of every signal received (-t); recording is a no-op without it
+static struct sig_trace trace;
+
+// watch pid as the opponent: a new server replaces the old one, whose
+// pidfd is closed so its exit can no longer end the current game
+static int watch_opponent(pid_t pid)
 {
-    (void)signum;
+    peer_mgr_close(&peers);
+    if (peer_mgr_init(&peers, 1) == -1)
+        return -1;
+    peers.retry_ns = BALL_RETRY_NS;
+    opponent = peer_add(&peers, pid);
+    if (opponent == -1)
+        perror("pidfd_open");
+    return opponent;
+}
+
+// graceful exit on SIGUSR2, dispatched from the main loop
+static void game_over(const struct sig_event *ev, const struct payload *p, void *state)
+{
+    (void)ev;
+    (void)p;
+    (void)state;
     printf("\a[RECEIVER] Game over! Exiting cleanly.\n");
     exit(0);
 }
 
-// runs automatically whenever SIGUSR1 signal arrives
-// all parameters are in place to match the standard function signature of sigaction()
-void handle_ball(int signum, siginfo_t *info, void *context)
+// plays one ball taken off the event queue (runs in main, not in a signal handler);
+// the runtime has already decoded its payload
+static void play_ball(const struct sig_event *ev, const struct payload *ball, void *state)
 {
-    // tell the compiler that you’re intentionally not using those parameters.
-    // this avoids any compile errors
-    (void)signum;
-    (void)context;
-
+    (void)state;
     // reading the sender info and current volley
-    // info->si_value.sival_int is the int value sent along with signal (volley count)
-    int volley = info->si_value.sival_int;
-    // info->si_pid is the PID of the sending process (opponent)
-    opponent_pid = info->si_pid;
+    // the value is a structured payload (payload.h): the volley count is its
+    // sequence number and it carries the time the opponent hit the ball;
+    // a plain sival_int from an older player decodes as just the count
+    int stamped = ball->op != PAYLOAD_OP_NONE;
+    int volley = (int)ball->seq;
+    // ev->pid is the PID of the sending process (opponent)
+    opponent_pid = ev->pid;
+
+    // the first serve tells us who we are playing: open a pidfd for them
+    // so we notice right away if they leave in the middle of the game
+    if (opponent < 0 || peers.peers[opponent].pid != opponent_pid) {
+        if (watch_opponent(opponent_pid) == -1)
+            exit(1);
+    }
 
     // \a is a bell character which makes the terminal beep
     // then it prints the volley number, who was received, and who sent it
-    printf("\a[RECEIVER] Received volley #%d from PID %d\n", volley, opponent_pid);
+    if (stamped)
+        printf("\a[RECEIVER] Received volley #%d from PID %d (in flight %.1f us)\n", volley, opponent_pid,
+               payload_age_ns(ball, mono_ns()) / 1e3);
+    else
+        printf("\a[RECEIVER] Received volley #%d from PID %d\n", volley, opponent_pid);
 
-    // check if the game is over, end game after 10 volleys
-    if (volley >= 10) {
+    // one ball in play: anything but the volley after our last hit was lost or is stale
+    if (stamped && last_hit > 0 && payload_seq_delta(ball->seq, (uint32_t)last_hit + 1) != 0)
+        printf("[RECEIVER] Expected volley #%d, got #%d (%s)\n", last_hit + 1, volley,
+               payload_seq_delta(ball->seq, (uint32_t)last_hit + 1) > 0 ? "balls lost" : "stale ball");
+
+    // check if the game is over, end game after max_volleys (10 by default)
+    if (volley >= max_volleys) {
         printf("[RECEIVER] Game over! Total volleys: %d\n", volley);
-        kill(opponent_pid, SIGUSR2);   // send graceful "end" signal
+        union sigval end = payload_encode(PAYLOAD_OP_END, 0, (uint32_t)volley);
+        peer_send(&peers, opponent, SIGUSR2, end);   // send graceful "end" signal
         exit(0);
     }
 
-    // Random delay between 1–2 seconds
-    // use xor to combine the time and pid value for a better random value
-    srand(time(NULL) ^ getpid());
-    // gives a zero or one
-    int delay = 1 + rand() % 2;
-    // wait for 1–2 seconds
-    sleep(delay);
+    // Random delay between 1–2 seconds (none in fast mode)
+    if (!fast) {
+        // use xor to combine the time and pid value for a better random value
+        srand(time(NULL) ^ getpid());
+        // gives a zero or one
+        int delay = 1 + rand() % 2;
+        // wait for 1–2 seconds
+        sleep(delay);
+    }
 
     // Send the signal back with incremented volley count
     // union sigval is a structure that holds an int or pointer
     // you can send with a signal, needed for sending value with sigqueue
-    union sigval sv;
-    // increment volley count by one
-    sv.sival_int = volley + 1;
-    // sigqueue sends SIGUSR1 back to opponent with new value
-    // sigqueue(target process id, signal type, value(expects union))
-    if (sigqueue(opponent_pid, SIGUSR1, sv) == -1) {
-        perror("sigqueue"); // print system error if fails
+    // increment volley count by one; payload_encode() also stamps the send time
+    union sigval sv = payload_encode(PAYLOAD_OP_BALL, 0, (uint32_t)(volley + 1));
+    last_hit = volley + 1;
+    // peer_send queues SIGUSR1 back through the opponent's pidfd with the new value,
+    // retrying while the opponent's signal queue is full instead of dropping the ball
+    if (peer_send(&peers, opponent, SIGUSR1, sv) == -1) {
+        // ESRCH means the opponent is gone; the main loop reports that
+        if (errno != ESRCH)
+            perror("pidfd_send_signal"); // print system error if it still fails
+        return;
     }
     // otherwise print confirmation 
     printf("\a[RECEIVER] Returned volley #%d to PID %d\n", volley + 1, opponent_pid);
 }
 
-int main(void)
+// called from peer_wait() when the opponent's pidfd reports that it exited
+static void opponent_left(struct peer_mgr *m, struct peer *p, void *arg)
 {
-    // declare the struct that holds the configuration info for signal handler
-    struct sigaction sa;
-    // fill the entire struct with zeros
-    // important because garbage values could make it non-zero
-    // or cause undefined behavior when sigaction() tries to read it
-    memset(&sa, 0, sizeof(sa));
-    // when the signal arrives, call the function to handle the ball
-    sa.sa_sigaction = handle_ball;
-
-    // Use the extended handler that takes three arguments (signum, siginfo_t*, and context)
-    // instead of the simple one-argument version
-    sa.sa_flags = SA_SIGINFO;
-
-    // sigaction(signal, new settings, old handler)
-    // returns negative one when failure occurs 
-    if (sigaction(SIGUSR1, &sa, NULL) == -1) {
-        perror("sigaction");
+    (void)m;
+    (void)arg;
+    printf("\a[RECEIVER] Opponent PID %d left the court. Game over!\n", p->pid);
+    opponent_gone = 1;
+}
+
+// trims the trace file however the game ends (including exit() in play_ball)
+static void close_trace(void)
+{
+    st_close(&trace);
+}
+
+int main(int argc, char *argv[])
+{
+    // -t file records every signal we receive, -r name lets a server find us
+    const char *court = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "fn:r:t:")) != -1) {
+        switch (opt) {
+        case 'f':
+            fast = 1;
+            break;
+        case 'n':
+            max_volleys = atoi(optarg);
+            break;
+        case 'r':
+            court = optarg;
+            break;
+        case 't':
+            if (st_create(&trace, optarg, 0) == -1)
+                return 1;
+            atexit(close_trace);
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-f] [-n volleys] [-r name] [-t trace_file]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (max_volleys < 1) {
+        fprintf(stderr, "volleys must be positive\n");
         return 1;
     }
 
-    // register graceful exit handler for SIGUSR2
-    struct sigaction sa_end;
-    memset(&sa_end, 0, sizeof(sa_end));
-    sa_end.sa_handler = handle_game_over;
-    sigaction(SIGUSR2, &sa_end, NULL);
+    // claim the name first so a server started alongside us can connect
+    // while we finish setting up; it only serves once we accept
+    int court_fd = -1;
+    if (court != NULL) {
+        court_fd = rdv_listen(court);
+        if (court_fd == -1) {
+            perror("rendezvous");
+            return 1;
+        }
+    }
+
+    // set up the handler -> main loop queue before any signal can arrive,
+    // and counters any scraper can read from /dev/shm (see metrics_dump);
+    // every signal also goes to the trace (a no-op without -t)
+    sigrt_init("recv_tennis");
+    sigrt_trace(&trace);
+
+    // one opponent at a time (watch_opponent() swaps in a new server)
+    if (peer_mgr_init(&peers, 1) == -1)
+        return 1;
+    peers.retry_ns = BALL_RETRY_NS;
+
+    // one handler per (signal, opcode): stamped and legacy balls alike go
+    // to play_ball(), anything on SIGUSR2 ends the game
+    sigrt_on(SIGUSR1, PAYLOAD_OP_BALL, play_ball, NULL);
+    sigrt_on(SIGUSR1, PAYLOAD_OP_NONE, play_ball, NULL);
+    sigrt_on(SIGUSR2, SIGRT_ANY_OP, game_over, NULL);
+
+    // keep both signals blocked except while waiting in sigsuspend(),
+    // so a ball can never interrupt the one we are playing
+    sigset_t waitmask;
+    if (sigrt_start(&waitmask) == -1)
+        return 1;
 
     // print updates
     printf("[RECEIVER] Ready. PID: %d\n", getpid());
+
+    // by name: the handlers are in place, so let the server in and watch it
+    if (court_fd >= 0) {
+        printf("[RECEIVER] Waiting for a server at court \"%s\"...\n", court);
+        fflush(stdout);
+        opponent_pid = rdv_accept(court_fd);
+        if (opponent_pid == -1) {
+            perror("rendezvous");
+            return 1;
+        }
+        if (watch_opponent(opponent_pid) == -1)
+            return 1;
+        printf("[RECEIVER] Opponent PID %d is on court\n", opponent_pid);
+    }
     printf("[RECEIVER] Waiting for serve...\n");
 
-    // puts process to sleep until next signal arrives
-    while (1) {
-        pause();
+    // puts the process to sleep until the next signal arrives or the
+    // opponent exits, then plays every ball the handler queued
+    while (!opponent_gone) {
+        if (peer_wait(&peers, -1, &waitmask, opponent_left, NULL) == -1) {
+            perror("epoll_pwait");
+            return 1;
+        }
+        sigrt_dispatch();
+        fflush(stdout);
     }
 
+    peer_mgr_close(&peers);
     return 0;
 }
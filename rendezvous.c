@@ -0,0 +1,161 @@
+/**
+ * @file        : rendezvous.c
+ * @brief       : Abstract-namespace SOCK_SEQPACKET handshake with SO_PEERCRED peer PIDs.
+ *
+ * Details      :
+ * - rdv_connect() spins with sched_yield() for the first few milliseconds
+ *   (a launcher starts both players together, so the waiter is usually
+ *   only an exec() away) and then backs off to short sleeps.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Extra Credit – Signal Tennis
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#define _GNU_SOURCE /* struct ucred */
+#include "rendezvous.h"
+
+#include <errno.h>
+#include <sched.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+
+#include "latency_hist.h"
+
+#define RDV_PREFIX "signal-tennis/"
+
+/* Yield between connect attempts this long, then sleep RDV_BACKOFF_NS */
+#define RDV_SPIN_NS    10000000ULL
+#define RDV_BACKOFF_NS 200000L
+
+/* Build the abstract address (leading NUL, no terminator); returns its length */
+static socklen_t rdv_address(const char *name, struct sockaddr_un *addr)
+{
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    int n = snprintf(addr->sun_path + 1, sizeof(addr->sun_path) - 1, RDV_PREFIX "%s", name);
+    if (n < 0 || strlen(name) > RDV_MAX_NAME) {
+        errno = ENAMETOOLONG;
+        return 0;
+    }
+    return (socklen_t)(offsetof(struct sockaddr_un, sun_path) + 1 + (size_t)n);
+}
+
+static pid_t peer_pid(int fd)
+{
+    struct ucred cred;
+    socklen_t len = sizeof(cred);
+    if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) == -1)
+        return -1;
+    return cred.pid;
+}
+
+int rdv_listen(const char *name)
+{
+    struct sockaddr_un addr;
+    socklen_t len = rdv_address(name, &addr);
+    if (len == 0)
+        return -1;
+
+    int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (fd == -1)
+        return -1;
+    if (bind(fd, (struct sockaddr *)&addr, len) == -1 || listen(fd, 1) == -1) {
+        int saved = errno;
+        close(fd);
+        errno = saved;
+        return -1;
+    }
+    return fd;
+}
+
+pid_t rdv_accept(int listen_fd)
+{
+    int fd;
+    while ((fd = accept(listen_fd, NULL, NULL)) == -1 && errno == EINTR)
+        ;
+    int saved = errno;
+    close(listen_fd);
+    if (fd == -1) {
+        errno = saved;
+        return -1;
+    }
+
+    pid_t pid = peer_pid(fd);
+    char ready = 'R';
+    if (pid <= 0 || write(fd, &ready, 1) != 1)
+        pid = -1;
+    saved = errno;
+    close(fd);
+    errno = saved;
+    return pid;
+}
+
+pid_t rdv_connect(const char *name, uint64_t timeout_ns)
+{
+    struct sockaddr_un addr;
+    socklen_t len = rdv_address(name, &addr);
+    if (len == 0)
+        return -1;
+
+    uint64_t start = mono_ns();
+    int fd;
+    for (;;) {
+        fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+        if (fd == -1)
+            return -1;
+        if (connect(fd, (struct sockaddr *)&addr, len) == 0)
+            break;
+        int saved = errno;
+        close(fd);
+        /* ECONNREFUSED: nobody has bound the name yet */
+        if (saved != ECONNREFUSED && saved != EINTR) {
+            errno = saved;
+            return -1;
+        }
+        uint64_t waited = mono_ns() - start;
+        if (waited >= timeout_ns) {
+            errno = ETIMEDOUT;
+            return -1;
+        }
+        if (waited < RDV_SPIN_NS) {
+            sched_yield();
+        } else {
+            struct timespec pause = { 0, RDV_BACKOFF_NS };
+            nanosleep(&pause, NULL);
+        }
+    }
+
+    /* The waiter's PID is known now, but only serve once it says it is ready,
+       which it must do within what is left of the timeout */
+    uint64_t left = timeout_ns - (mono_ns() - start);
+    if ((int64_t)left < 1000)
+        left = 1000;
+    struct timeval tv = { (time_t)(left / 1000000000ULL), (suseconds_t)(left % 1000000000ULL / 1000) };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    pid_t pid = peer_pid(fd);
+    char ready;
+    ssize_t n;
+    while ((n = read(fd, &ready, 1)) == -1 && errno == EINTR)
+        ;
+    if (n != 1) {
+        if (n == 0)
+            errno = ECONNRESET; /* the waiter exited before it was ready */
+        else if (errno == EAGAIN || errno == EWOULDBLOCK)
+            errno = ETIMEDOUT;
+        pid = -1;
+    }
+    int saved = errno;
+    close(fd);
+    errno = saved;
+    return pid;
+}
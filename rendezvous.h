@@ -0,0 +1,55 @@
+/**
+ * @file        : rendezvous.h
+ * @brief       : Abstract UNIX socket handshake so two players find each other by name, not PID.
+ *
+ * Details      :
+ * - The waiting side (recv_tennis) binds "signal-tennis/<name>" in the
+ *   abstract socket namespace: nothing to clean up on disk, and the name
+ *   disappears with the process.
+ * - The serving side connects to that name, retrying until the waiter is
+ *   listening. Each side learns the other's PID from SO_PEERCRED, which the
+ *   kernel fills in, so no PID is ever typed, printed or parsed.
+ * - The waiter writes one byte once its handlers are installed; the server
+ *   serves only after reading it, so the first ball can never arrive
+ *   before the opponent is ready to catch it.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Extra Credit – Signal Tennis
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#ifndef RENDEZVOUS_H
+#define RENDEZVOUS_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+/* Longest rendezvous name (without the "signal-tennis/" prefix) */
+#define RDV_MAX_NAME 80
+
+/* How long rdv_connect() waits for the other side by default */
+#define RDV_TIMEOUT_NS 5000000000ULL
+
+/**
+ * @brief Waiter: claim @p name so a server can connect.
+ * @return Listening socket, or -1 on failure (EADDRINUSE if the name is taken).
+ */
+int rdv_listen(const char *name);
+
+/**
+ * @brief Waiter: take the server's connection, tell it we are ready and
+ *        close both sockets.
+ * @return The server's PID, or -1 on failure.
+ */
+pid_t rdv_accept(int listen_fd);
+
+/**
+ * @brief Server: connect to @p name, retrying for up to @p timeout_ns while
+ *        nobody listens yet, and wait until the waiter says it is ready.
+ * @return The waiter's PID, or -1 on failure (ETIMEDOUT if nobody showed up).
+ */
+pid_t rdv_connect(const char *name, uint64_t timeout_ns);
+
+#endif /* RENDEZVOUS_H */
@@ -0,0 +1,97 @@
+/**
+ * @file        : rt_channel.c
+ * @brief       : Real-time signal channel mapping, sequence tracking and queue headroom.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "rt_channel.h"
+
+#include <signal.h>
+#include <string.h>
+#include <sys/resource.h>
+
+int rt_channel_count(void)
+{
+    int n = SIGRTMAX - SIGRTMIN + 1 - RT_RESERVED_SIGNALS;
+    return n > RT_MAX_CHANNELS ? RT_MAX_CHANNELS : n;
+}
+
+int rt_channel_signo(int channel)
+{
+    if (channel < 0 || channel >= rt_channel_count())
+        return -1;
+    return SIGRTMIN + channel;
+}
+
+int rt_channel_of(int signo)
+{
+    if (signo < SIGRTMIN || signo > SIGRTMAX - RT_RESERVED_SIGNALS)
+        return -1;
+    return rt_channel_signo(signo - SIGRTMIN) == -1 ? -1 : signo - SIGRTMIN;
+}
+
+uint32_t rt_stream_accept(struct rt_stream *stream, uint32_t seq)
+{
+    uint32_t skipped = 0;
+    int32_t delta = payload_seq_delta(seq, stream->next_seq);
+
+    stream->received++;
+    if (delta == 0) {
+        stream->next_seq = (seq + 1) & PAYLOAD_SEQ_MASK;
+    } else if (delta > 0) {
+        /* Forward jump: everything in between never arrived */
+        skipped = (uint32_t)delta;
+        stream->gaps++;
+        stream->missing += skipped;
+        stream->next_seq = (seq + 1) & PAYLOAD_SEQ_MASK;
+    } else {
+        stream->reordered++;
+    }
+    return skipped;
+}
+
+int rt_sigpending_usage(long *queued, long *limit)
+{
+    struct rlimit rl;
+    if (getrlimit(RLIMIT_SIGPENDING, &rl) == -1)
+        return -1;
+    *limit = rl.rlim_cur == RLIM_INFINITY ? -1 : (long)rl.rlim_cur;
+
+    /* "SigQ:\t<queued>/<limit>" counts signals queued for our real UID */
+    *queued = -1;
+    FILE *fp = fopen("/proc/self/status", "r");
+    if (fp == NULL)
+        return 0;
+
+    char line[256];
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        if (strncmp(line, "SigQ:", 5) == 0) {
+            long q, l;
+            if (sscanf(line + 5, "%ld/%ld", &q, &l) == 2)
+                *queued = q;
+            break;
+        }
+    }
+    fclose(fp);
+    return 0;
+}
+
+void rt_print_headroom(FILE *out)
+{
+    long queued, limit;
+    if (rt_sigpending_usage(&queued, &limit) == -1) {
+        fprintf(out, "RLIMIT_SIGPENDING: unavailable\n");
+        return;
+    }
+    if (limit < 0)
+        fprintf(out, "RLIMIT_SIGPENDING: %ld queued / unlimited\n", queued);
+    else
+        fprintf(out, "RLIMIT_SIGPENDING: %ld queued / %ld limit (headroom %ld)\n",
+                queued, limit, queued < 0 ? limit : limit - queued);
+}
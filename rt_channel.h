@@ -0,0 +1,77 @@
+/**
+ * @file        : rt_channel.h
+ * @brief       : Multi-channel transport on the real-time signals SIGRTMIN..SIGRTMAX.
+ *
+ * Details      :
+ * - Channel N is carried by signal SIGRTMIN + N. Real-time signals are queued
+ *   (never merged like SIGUSR1) and delivered in order per signal number,
+ *   so each channel is an ordered logical stream.
+ * - Every message carries a per-channel sequence number (the 22-bit
+ *   sequence field of payload.h); the receiver tracks gaps and out-of-order
+ *   arrivals per channel, modulo 2^22.
+ * - The top RT_RESERVED_SIGNALS signals are kept for control traffic
+ *   (SIGRTMAX carries flow-control credit, see flow_ctl.h, and
+ *   SIGRTMAX - 1 asks for a metrics snapshot, see sig_metrics.h) and are never
+ *   handed out as data channels.
+ * - Queued signals are charged to RLIMIT_SIGPENDING of the receiving user;
+ *   rt_sigpending_usage() reports how much of it is in use.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#ifndef RT_CHANNEL_H
+#define RT_CHANNEL_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "payload.h"
+
+/* Upper bound on channels for static tables (SIGRTMAX - SIGRTMIN is 30–32 on Linux) */
+#define RT_MAX_CHANNELS 64
+
+/* Signals at the top of the range kept back from the channel map */
+#define RT_RESERVED_SIGNALS 2
+
+/** Per-channel receive statistics */
+struct rt_stream
+{
+    uint32_t next_seq;   /* sequence number expected next */
+    uint64_t received;   /* messages delivered */
+    uint64_t gaps;       /* times a forward jump in sequence was seen */
+    uint64_t missing;    /* total sequence numbers skipped by those jumps */
+    uint64_t reordered;  /* messages older than next_seq */
+};
+
+/** @brief Number of usable channels on this system. */
+int rt_channel_count(void);
+
+/** @brief Signal number carrying @p channel, or -1 if out of range. */
+int rt_channel_signo(int channel);
+
+/** @brief Channel carried by @p signo, or -1 if it is not a channel signal. */
+int rt_channel_of(int signo);
+
+/**
+ * @brief Account for message @p seq (22 bits, see payload.h) on @p stream.
+ * @return Number of sequence numbers skipped before @p seq (0 when in order).
+ */
+uint32_t rt_stream_accept(struct rt_stream *stream, uint32_t seq);
+
+/**
+ * @brief Read current RLIMIT_SIGPENDING usage for this user.
+ *
+ * @param queued Signals currently queued for the real user ID (-1 if unknown).
+ * @param limit  Soft RLIMIT_SIGPENDING (-1 if unlimited).
+ * @return 0 on success, -1 on failure.
+ */
+int rt_sigpending_usage(long *queued, long *limit);
+
+/** @brief Print "queued/limit (headroom)" to @p out. */
+void rt_print_headroom(FILE *out);
+
+#endif /* RT_CHANNEL_H */
@@ -6,6 +6,34 @@
  * - Takes the target process PID as a command-line argument.
  * - Seeds PRNG with current time and generates a random int (0–99).
  * - Sends SIGUSR1 with integer payload via sigqueue().
+ * - With -c/-k/-n, sends a numbered stream instead: message i on channel c
+ *   goes out on signal SIGRTMIN + c. Real-time signals are queued, so no
+ *   message is merged away like SIGUSR1 would be.
+ * - Stream and load messages carry a structured payload (payload.h) in the
+ *   full 64-bit sival_ptr: opcode, channel, sequence number and send time,
+ *   so the receiver measures one-way latency and loss per message.
+ * - With -s, bulk bytes (stdin, or -b generated bytes) are copied into the
+ *   receiver's shared-memory ring. SIGUSR1 is sent only as a doorbell when
+ *   the ring goes from empty to non-empty, with the new tail in sival_int;
+ *   SIGUSR2 carries the final tail when the stream ends.
+ * - With -R/-d, runs as an open-loop load generator: messages are sent at a
+ *   fixed rate for a fixed time, round-robin over one or more target PIDs and
+ *   channels, each carrying its per-target, per-channel sequence number.
+ *   Every send is scheduled on an absolute deadline, so a slow receiver
+ *   cannot slow the offered load down; it shows up as send latency and
+ *   failures instead. Targets are opened as pidfds (peer_mgr.c): sends use
+ *   pidfd_send_signal(), so a recycled PID is never hit, and a target that
+ *   exits is reported through epoll and dropped from the rotation.
+ * - With -W, the -n stream is flow controlled: at most W messages are in
+ *   flight and the receiver (recv_signal -a) returns credit with
+ *   FLOW_ACK_SIGNAL, so the stream never overflows the pending queue.
+ * - With -T name, the stream goes to the receiver in routing table "name"
+ *   (recv_signal -w N -T name): every message is queued with
+ *   rt_tgsigqueueinfo() on the worker thread that owns its channel instead
+ *   of on the whole process.
+ * - Every send refused with EAGAIN (including the retries inside
+ *   peer_mgr.c and flow_ctl.c) is counted per signal in a shared metrics
+ *   page (sig_metrics.h) that metrics_dump can read during the run.
  *
  * Course       : CPE 2600 – Systems Programming
  * Section      : 112
@@ -13,32 +41,497 @@
  * Modified by  : Jesse Rost <rostj@msoe.edu>
  * Date         : 11/10/25
  *
- * Compile      : gcc -Wall -Wextra send_signal.c -o send_signal
- * Usage        : ./send_signal <pid>
+ * Compile      : make send_signal
+ * Usage        : ./send_signal [-c channel] [-k channels] [-n count] [-W window] <pid>
+ *                ./send_signal -s name [-b bytes] < data
+ *                ./send_signal -T name [-c channel] [-k channels] [-n count]
+ *                ./send_signal -R rate [-d seconds] [-c channel] [-k channels] <pid>...
  * Example      : ./send_signal 12345
+ *                ./send_signal -c 0 -k 4 -n 10000 12345
+ *                ./send_signal -c 0 -n 1000000 -W 256 12345
+ *                ./send_signal -s /sigring -b 1000000000
+ *                ./send_signal -T /sigroute -c 0 -k 8 -n 100000
+ *                ./send_signal -R 50000 -d 10 -c 0 -k 4 12345 12346
  *
  * Algorithm
- *  - Parse PID from argv.
- *  - Seed PRNG and generate a random int.
- *  - Populate union sigval and call sigqueue().
+ *  - Parse options and PID from argv.
+ *  - Single message: seed PRNG, generate a random int and sigqueue() it.
+ *  - Stream: round-robin over the channels, sending the next sequence number
+ *    of each; sigqueue() is retried while the receiver's queue is full.
+ *    With -W, each send first waits until fewer than W messages are unacked.
+ *  - Ring: map the ring, copy data in, ring the doorbell only when the
+ *    consumer had caught up, and yield while the ring is full.
+ *  - Load: message i is due at start + i / rate. Sleep until its deadline
+ *    with clock_nanosleep(TIMER_ABSTIME), then sigqueue() it; on EAGAIN keep
+ *    retrying until the next message is due, then count it as failed.
  */
 
 #define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <signal.h>
 #include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/prctl.h>
+
+#include "rt_channel.h"
+#include "shm_ring.h"
+#include "latency_hist.h"
+#include "flow_ctl.h"
+#include "peer_mgr.h"
+#include "sig_router.h"
+#include "payload.h"
+#include "sig_metrics.h"
+
+/* Producer copy size for ring mode */
+#define RING_CHUNK 65536
+
+/* Most target PIDs the load generator drives at once */
+#define MAX_TARGETS 4096
+
+/* Load generator messages between checks for exited targets */
+#define EXIT_CHECK_EVERY 1024
+
+/* Per-target load generator state (delivered count lives in struct peer) */
+struct load_target {
+    long failed;        /* messages given up on */
+    int next_slot;
+    uint32_t seq[RT_MAX_CHANNELS];
+};
+
+/**
+ * @brief Send @p count numbered messages round-robin over @p channels channels.
+ *        A channel of -1 means plain SIGUSR1. A @p window above 0 turns on
+ *        credit-based flow control against a receiver running with -a.
+ *        With a @p router, each message goes to the thread owning its channel.
+ */
+static int send_stream(pid_t target_pid, int first, int channels, long count, uint32_t window,
+                       struct sig_router *router)
+{
+    uint32_t seq[RT_MAX_CHANNELS] = {0};
+    long eagain = 0;
+    struct flow_sender flow;
+    uint64_t start = mono_ns();
+
+    if (window > 0 && flow_sender_init(&flow, target_pid, window) == -1)
+    {
+        perror("flow_sender_init");
+        return 1;
+    }
+
+    for (long i = 0; i < count; i++)
+    {
+        int slot = (int)(i % channels);
+        int signo = first < 0 ? SIGUSR1 : rt_channel_signo(first + slot);
+
+        union sigval sig_data = payload_encode(PAYLOAD_OP_DATA, first < 0 ? 0 : (unsigned)(first + slot),
+                                               seq[slot]);
+
+        if (window > 0)
+        {
+            if (flow_send(&flow, signo, sig_data) == -1)
+            {
+                perror("flow_send");
+                return 1;
+            }
+            seq[slot]++;
+            continue;
+        }
+
+        /* Queue full: give the receiver a chance to drain, then retry */
+        while ((router != NULL ? router_send(router, signo, first + slot, sig_data)
+                               : sigqueue(target_pid, signo, sig_data)) == -1)
+        {
+            if (errno != EAGAIN)
+            {
+                perror(router != NULL ? "rt_tgsigqueueinfo" : "sigqueue");
+                return 1;
+            }
+            eagain++;
+            sm_queue_full(signo);
+            sched_yield();
+        }
+        seq[slot]++;
+    }
+
+    double secs = (mono_ns() - start) / 1e9;
+    if (window > 0)
+        printf("Sent %ld messages on %d channel(s) to PID %d in %.3f s (%.0f msg/s), window %u: "
+               "%llu acks, %llu credit stalls, %llu EAGAIN retries\n",
+               count, channels, target_pid, secs, secs > 0 ? count / secs : 0.0, window,
+               (unsigned long long)flow.acks, (unsigned long long)flow.stalls,
+               (unsigned long long)flow.eagain);
+    else
+        printf("Sent %ld messages on %d channel(s) to PID %d in %.3f s (%.0f msg/s, %ld EAGAIN retries)\n",
+               count, channels, target_pid, secs, secs > 0 ? count / secs : 0.0, eagain);
+    if (router != NULL)
+        printf("Routed %llu to their shard's thread, %llu process-directed (shard had no thread)\n",
+               (unsigned long long)router->routed, (unsigned long long)router->fallback);
+    rt_print_headroom(stdout);
+    return 0;
+}
+
+/**
+ * @brief Stream bulk data through the receiver's shared-memory ring.
+ *        @p total < 0 copies stdin, otherwise @p total generated bytes are sent.
+ */
+static int send_ring(const char *name, long long total)
+{
+    struct shm_ring ring;
+    if (shm_ring_open(&ring, name) == -1)
+        return 1;
+
+    pid_t target_pid = ring.hdr->consumer_pid;
+    static unsigned char chunk[RING_CHUNK];
+    long long sent = 0;
+    long doorbells = 0;
+    uint64_t start = mono_ns();
+
+    /* Generated data is a simple counting pattern the receiver can checksum */
+    for (size_t i = 0; i < sizeof(chunk); i++)
+        chunk[i] = (unsigned char)i;
+
+    while (total < 0 || sent < total)
+    {
+        size_t len = sizeof(chunk);
+        if (total < 0)
+        {
+            ssize_t got = read(STDIN_FILENO, chunk, sizeof(chunk));
+            if (got <= 0)
+                break;
+            len = (size_t)got;
+        }
+        else if ((long long)len > total - sent)
+        {
+            len = (size_t)(total - sent);
+        }
+
+        size_t off = 0;
+        while (off < len)
+        {
+            int was_empty;
+            size_t put = shm_ring_write(&ring, chunk + off, len - off, &was_empty);
+            if (put == 0)
+            {
+                sched_yield(); /* ring full: let the consumer drain */
+                continue;
+            }
+            off += put;
+
+            if (was_empty)
+            {
+                union sigval doorbell;
+                doorbell.sival_int = (int)shm_ring_tail(&ring);
+                if (sigqueue(target_pid, SIGUSR1, doorbell) == -1)
+                {
+                    if (errno != EAGAIN)
+                    {
+                        perror("sigqueue");
+                        shm_ring_close(&ring, NULL);
+                        return 1;
+                    }
+                    sm_queue_full(SIGUSR1);
+                }
+                doorbells++;
+            }
+        }
+        sent += (long long)len;
+    }
+
+    /* End of stream: final tail, so the receiver knows it has everything */
+    union sigval end;
+    end.sival_int = (int)shm_ring_tail(&ring);
+    if (sigqueue(target_pid, SIGUSR2, end) == -1)
+        perror("sigqueue");
+
+    double secs = (mono_ns() - start) / 1e9;
+    printf("Sent %lld bytes to PID %d with %ld doorbells in %.3f s (%.1f MB/s)\n",
+           sent, target_pid, doorbells, secs, secs > 0 ? sent / secs / 1e6 : 0.0);
+    shm_ring_close(&ring, NULL);
+    return 0;
+}
+
+/* Add @p ns nanoseconds to an absolute CLOCK_MONOTONIC time */
+static struct timespec deadline_after(const struct timespec *start, uint64_t ns)
+{
+    struct timespec t = *start;
+    t.tv_sec += (time_t)(ns / 1000000000ull);
+    t.tv_nsec += (long)(ns % 1000000000ull);
+    if (t.tv_nsec >= 1000000000L) {
+        t.tv_sec++;
+        t.tv_nsec -= 1000000000L;
+    }
+    return t;
+}
+
+static uint64_t timespec_ns(const struct timespec *t)
+{
+    return (uint64_t)t->tv_sec * 1000000000ull + (uint64_t)t->tv_nsec;
+}
+
+/* peer_wait() callback: a load target went away */
+static void report_exit(struct peer_mgr *m, struct peer *p, void *arg)
+{
+    (void)m;
+    (void)arg;
+    printf("  PID %d exited after %llu messages\n", p->pid, (unsigned long long)p->sent);
+}
+
+/**
+ * @brief Open-loop load: @p rate messages per second for @p seconds, spread
+ *        round-robin over the @p npids PIDs in @p pids and @p channels channels.
+ *        Targets are held as pidfds, so an exited target is noticed through
+ *        epoll and dropped, and its recycled PID is never signalled.
+ */
+static int send_load(char **pids, int npids, int first, int channels,
+                     double rate, double seconds)
+{
+    static struct latency_hist latency;
+    static struct peer_mgr peers;
+    hist_init(&latency);
+
+    struct load_target *targets = calloc((size_t)npids, sizeof(*targets));
+    if (targets == NULL)
+    {
+        perror("calloc");
+        return 1;
+    }
+    /* peer_mgr_init() prints its own error */
+    if (peer_mgr_init(&peers, npids) == -1)
+    {
+        free(targets);
+        return 1;
+    }
+    for (int k = 0; k < npids; k++)
+    {
+        pid_t pid = (pid_t)atoi(pids[k]);
+        if (peer_add(&peers, pid) == -1)
+            fprintf(stderr, "PID %d: %s\n", pid, strerror(errno));
+    }
+    if (peers.count == 0)
+    {
+        free(targets);
+        peer_mgr_close(&peers);
+        return 1;
+    }
+
+    long total = (long)(rate * seconds);
+    long eagain = 0;
+    long late = 0;
+    /* The default 50 us timer slack would make every short sleep overshoot */
+    prctl(PR_SET_TIMERSLACK, 1UL, 0UL, 0UL, 0UL);
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    printf("Offering %.0f msg/s for %.1f s to %d PID(s) on %d channel(s)...\n",
+           rate, seconds, peers.count, channels);
+    fflush(stdout);
+
+    int idx = 0;
+    for (long i = 0; i < total; i++)
+    {
+        /* Exits are cheap to collect: one epoll_wait for any number of them */
+        if (i % EXIT_CHECK_EVERY == 0)
+            peer_wait(&peers, 0, NULL, report_exit, NULL);
+        if (peers.alive == 0)
+        {
+            printf("All targets exited; stopping after %ld messages\n", i);
+            break;
+        }
+
+        /* Round-robin over the targets that are still alive */
+        while (peers.peers[idx].pidfd < 0)
+            idx = (idx + 1) % peers.count;
+        struct load_target *t = &targets[idx];
+        int slot = t->next_slot;
+        t->next_slot = (slot + 1) % channels;
+        int signo = first < 0 ? SIGUSR1 : rt_channel_signo(first + slot);
+
+        /* Open loop: deadline i depends only on the start time, never on how
+           long earlier sends took, so a stalled receiver cannot hide backlog.
+           Computed from i each time: a truncated period would drift the rate up */
+        struct timespec due = deadline_after(&start, (uint64_t)((double)i * 1e9 / rate));
+        uint64_t due_ns = timespec_ns(&due);
+        uint64_t next_ns = timespec_ns(&start) + (uint64_t)((double)(i + 1) * 1e9 / rate);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &due, NULL) == EINTR)
+            ;
+
+        /* Stamped after the sleep: the send time is when it really goes out */
+        union sigval sig_data = payload_encode(PAYLOAD_OP_DATA, (unsigned)(first + slot), t->seq[slot]++);
+
+        int ok = 0;
+        for (;;)
+        {
+            if (peer_send(&peers, idx, signo, sig_data) == 0)
+            {
+                ok = 1;
+                break;
+            }
+            if (errno == ESRCH)
+            {
+                peer_wait(&peers, 0, NULL, report_exit, NULL);
+                break;
+            }
+            if (errno != EAGAIN)
+                break; /* EPERM: nothing to retry for */
+            eagain++;
+            if (mono_ns() >= next_ns)
+                break; /* still full when the next message is due: drop this one */
+            sched_yield();
+        }
+        if (!ok)
+            t->failed++;
+
+        uint64_t done = mono_ns();
+        hist_record(&latency, done - due_ns);
+        if (done > next_ns)
+            late++;
+        idx = (idx + 1) % peers.count;
+    }
+
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double secs = (timespec_ns(&end) - timespec_ns(&start)) / 1e9;
+
+    unsigned long long sent = 0, failed = 0;
+    for (int k = 0; k < peers.count; k++)
+    {
+        const struct peer *p = &peers.peers[k];
+        if (peers.count <= 16)
+            printf("  PID %-7d sent %llu, failed %ld%s\n", p->pid, (unsigned long long)p->sent,
+                   targets[k].failed, p->pidfd < 0 ? " (exited)" : "");
+        sent += p->sent;
+        failed += (unsigned long long)targets[k].failed;
+    }
+    printf("Offered %.0f msg/s, achieved %.0f msg/s: %llu sent, %llu failed, %ld EAGAIN retries, "
+           "%ld sends past the next deadline, %d of %d targets still alive\n",
+           rate, secs > 0 ? sent / secs : 0.0, sent, failed, eagain, late, peers.alive, peers.count);
+    hist_print(&latency, "Send latency (from schedule)", stdout);
+    rt_print_headroom(stdout);
+
+    free(targets);
+    peer_mgr_close(&peers);
+    return failed > 0;
+}
 
 int main(int argc, char *argv[])
 {
-    if (argc != 2)
+    int first = -1;
+    int channels = 1;
+    long count = 0;
+    const char *ring_name = NULL;
+    long long ring_bytes = -1;
+    double rate = 0;
+    double seconds = 1.0;
+    uint32_t window = 0;
+    const char *route_name = NULL;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "c:k:n:s:b:R:d:W:T:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'T':
+            route_name = optarg;
+            break;
+        case 'W':
+            window = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'R':
+            rate = atof(optarg);
+            break;
+        case 'd':
+            seconds = atof(optarg);
+            break;
+        case 's':
+            ring_name = optarg;
+            break;
+        case 'b':
+            ring_bytes = atoll(optarg);
+            break;
+        case 'c':
+            first = atoi(optarg);
+            break;
+        case 'k':
+            channels = atoi(optarg);
+            break;
+        case 'n':
+            count = atol(optarg);
+            break;
+        default:
+            optind = argc + 1; /* force the usage message below */
+            break;
+        }
+    }
+
+    sm_open("send_signal");
+
+    if (ring_name != NULL && optind == argc)
+        return send_ring(ring_name, ring_bytes);
+
+    if (route_name != NULL && optind == argc && window == 0 && rate == 0)
+    {
+        if (first < 0)
+            first = 0; /* routing is by channel */
+        if (channels < 1 || rt_channel_signo(first + channels - 1) == -1)
+        {
+            fprintf(stderr, "Channels %d..%d out of range (0..%d)\n",
+                    first, first + channels - 1, rt_channel_count() - 1);
+            return 1;
+        }
+        struct sig_router router;
+        if (router_open(&router, route_name) == -1)
+            return 1;
+        int status = send_stream(router.table->tgid, first, channels, count > 0 ? count : 1, 0, &router);
+        router_close(&router, NULL);
+        return status;
+    }
+
+    if (rate > 0 && optind < argc && argc - optind <= MAX_TARGETS && seconds > 0)
+    {
+        if (first < 0)
+            first = 0; /* sequence checking needs queued signals, not SIGUSR1 */
+        if (channels < 1 || rt_channel_signo(first + channels - 1) == -1)
+        {
+            fprintf(stderr, "Channels %d..%d out of range (0..%d)\n",
+                    first, first + channels - 1, rt_channel_count() - 1);
+            return 1;
+        }
+        return send_load(&argv[optind], argc - optind, first, channels, rate, seconds);
+    }
+
+    if (optind != argc - 1)
     {
-        fprintf(stderr, "Usage: %s <pid>\n", argv[0]);
+        fprintf(stderr, "Usage: %s [-c channel] [-k channels] [-n count] [-W window] <pid>\n"
+                        "       %s -s name [-b bytes]\n"
+                        "       %s -T name [-c channel] [-k channels] [-n count]\n"
+                        "       %s -R rate [-d seconds] [-c channel] [-k channels] <pid>... (up to %d)\n",
+                argv[0], argv[0], argv[0], argv[0], MAX_TARGETS);
         return 1;
     }
 
     /* Convert command-line argument to PID */
-    pid_t target_pid = (pid_t)atoi(argv[1]);
+    pid_t target_pid = (pid_t)atoi(argv[optind]);
+
+    if (window > 0 && first < 0)
+        first = 0; /* SIGUSR1 merges, so its count could never be fully acked */
+
+    if (first >= 0 || count > 0)
+    {
+        if (first >= 0 && (channels < 1 || rt_channel_signo(first + channels - 1) == -1))
+        {
+            fprintf(stderr, "Channels %d..%d out of range (0..%d)\n",
+                    first, first + channels - 1, rt_channel_count() - 1);
+            return 1;
+        }
+        if (first < 0)
+            channels = 1;
+        return send_stream(target_pid, first, channels, count > 0 ? count : 1, window, NULL);
+    }
 
     /* Seed random number generator */
     srand((unsigned int)time(NULL));
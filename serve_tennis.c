@@ -3,10 +3,21 @@
  * @brief       : "Signal Tennis" server player — initiates and rallies signals with another process.
  *
  * Details      :
- * - Registers a handler for SIGUSR1 ("the ball").
+ * - Registers a handler for SIGUSR1 ("the ball") in the signal runtime's
+ *   (signal, opcode) table (sigrt.h): ball payloads go to play_ball() and
+ *   the end signal to game_over(), with no handler code of its own.
  * - Serves the first signal with volley count = 1.
  * - Each side randomly delays 1–2 seconds between hits.
  * - Ends the game cleanly after 10 volleys.
+ * - Watches the opponent through a pidfd, so the game ends at once if the
+ *   opponent process dies instead of waiting for a ball that never comes.
+ * - Instead of a PID, -r name finds a receiver started with the same name
+ *   (rendezvous.c), so tennis_launch can start both players unattended.
+ * - -f plays fast (no pacing delays) and -n sets the game length; -S fd
+ *   writes the serve time (CLOCK_MONOTONIC ns) to fd for setup timing.
+ * - Every ball is a structured payload (payload.h) with the volley count and
+ *   the time it was hit, so each side prints how long the ball was in
+ *   flight and notices a volley that is not the one after its last hit.
  *
  * Course       : CPE 2600 – Systems Programming
  * Section      : 112
@@ -14,94 +25,144 @@
  * Author       : rostj@msoe.edu <Jesse Rost>
  * Date         : 11/10/25
  *
- * Compile      : gcc -Wall -Wextra serve_tennis.c -o serve_tennis
- * Usage        : ./serve_tennis <receiver_pid>
+ * Compile      : make serve_tennis
+ * Usage        : ./serve_tennis [-f] [-n volleys] [-S fd] <receiver_pid | -r name>
  *
  * Algorithm
- *  1. Parse the command-line argument to get the opponent’s PID.
- *  2. Install a signal handler for SIGUSR1 using sigaction().
+ *  1. Parse the command-line argument to get the opponent’s PID, or find
+ *     the opponent by rendezvous name and wait until it is ready.
+ *  2. Register play_ball() for SIGUSR1 and game_over() for SIGUSR2; the
+ *     runtime installs its queueing handler for both with sigaction().
  *  3. Print confirmation of setup (own PID and opponent PID).
- *  4. Wait one second, then “serve” the first volley by sending SIGUSR1
- *     with sival_int = 1 to the opponent process.
- *  5. Enter an infinite pause loop, waiting for incoming volleys handled
- *     by handle_ball().
+ *  4. Wait one second (unless -f), then “serve” the first volley by sending SIGUSR1
+ *     with volley 1 (payload.h) to the opponent process.
+ *  5. Wait in epoll_pwait() on the opponent's pidfd with the signals
+ *     unblocked (like sigsuspend); the runtime queues each incoming volley,
+ *     sigrt_dispatch() hands it to play_ball() which returns it, and the
+ *     opponent exiting ends the game.
  */
 
 #define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdlib.h>
 #include <signal.h>
-#include <string.h>
 #include <unistd.h>
 #include <time.h>
+#include <errno.h>
+
+#include "sigrt.h"
+#include "peer_mgr.h"
+#include "rendezvous.h"
+#include "payload.h"
+#include "latency_hist.h"
+
+// how long to keep retrying a ball the opponent has no room to queue (EAGAIN)
+#define BALL_RETRY_NS 1000000000ULL
 
 /** 
  * @brief This will hold the PID of the receiver process.
  */
 static pid_t opponent_pid = 0;
 
+// game length (-n) and whether to skip the 1–2 second pacing (-f)
+static int max_volleys = 10;
+static int fast = 0;
+
+// the last volley we hit, so the next one back can be checked
+static int last_hit = 0;
+
+// the opponent opened as a pidfd: sends can never hit a recycled PID,
+// and the pidfd turns readable the moment the opponent exits
+static struct peer_mgr peers;
+static int opponent = -1;
+static int opponent_gone = 0;
+
 /**
- * @brief Graceful exit handler for SIGUSR2.
- *        Prints message and exits cleanly instead of being killed.
+ * @brief Graceful exit for SIGUSR2, dispatched from the main loop.
  */
-void handle_game_over(int signum)
+static void game_over(const struct sig_event *ev, const struct payload *p, void *state)
 {
-    (void)signum;
+    (void)ev;
+    (void)p;
+    (void)state;
     printf("\a[SERVER] Game over! Exiting cleanly.\n");
     exit(0);
 }
 
 /**
- * @brief Runs automatically whenever a SIGUSR1 signal arrives.
+ * @brief Plays one ball taken off the event queue (runs in main, not in a signal handler).
  *
- * @param signum   The signal number.
- * @param info     Pointer containing info about the signal (sender PID, sent data).
- * @param context  CPU context (unused, but required by function signature).
+ * @param ev     The queued SIGUSR1 (sender PID).
+ * @param ball   Its decoded payload (volley count and hit time).
+ * @param state  Unused; registered as NULL.
  */
-void handle_ball(int signum, siginfo_t *info, void *context)
+static void play_ball(const struct sig_event *ev, const struct payload *ball, void *state)
 {
-    // tell the compiler that you’re intentionally not using those parameters.
-    // this avoids any compile errors
-    (void)signum;
-    (void)context;
-
+    (void)state;
     // reading the sender info and current volley
-    // info->si_value.sival_int is the int value sent along with signal (volley count)
-    int volley = info->si_value.sival_int;
-    // info->si_pid is the PID of the sending process (opponent)
-    opponent_pid = info->si_pid;
+    // the value is a structured payload (payload.h): the volley count is its
+    // sequence number and it carries the time the opponent hit the ball;
+    // a plain sival_int from an older player decodes as just the count
+    int stamped = ball->op != PAYLOAD_OP_NONE;
+    int volley = (int)ball->seq;
+    // ev->pid is the PID of the sending process (opponent)
+    opponent_pid = ev->pid;
 
     // \a is a bell character which makes the terminal beep
     // then it prints the volley number, who was received, and who sent it
-    printf("\a[RECEIVER] Received volley #%d from PID %d\n", volley, opponent_pid);
+    if (stamped)
+        printf("\a[SERVER] Received volley #%d from PID %d (in flight %.1f us)\n", volley, opponent_pid,
+               payload_age_ns(ball, mono_ns()) / 1e3);
+    else
+        printf("\a[SERVER] Received volley #%d from PID %d\n", volley, opponent_pid);
 
-    // check if the game is over, end game after 10 volleys
-    if (volley >= 10) {
-        printf("[RECEIVER] Game over! Total volleys: %d\n", volley);
-        kill(opponent_pid, SIGUSR2);   // send graceful "end" signal
+    // one ball in play: anything but the volley after our last hit was lost or is stale
+    if (stamped && last_hit > 0 && payload_seq_delta(ball->seq, (uint32_t)last_hit + 1) != 0)
+        printf("[SERVER] Expected volley #%d, got #%d (%s)\n", last_hit + 1, volley,
+               payload_seq_delta(ball->seq, (uint32_t)last_hit + 1) > 0 ? "balls lost" : "stale ball");
+
+    // check if the game is over, end game after max_volleys (10 by default)
+    if (volley >= max_volleys) {
+        printf("[SERVER] Game over! Total volleys: %d\n", volley);
+        union sigval end = payload_encode(PAYLOAD_OP_END, 0, (uint32_t)volley);
+        peer_send(&peers, opponent, SIGUSR2, end);   // send graceful "end" signal
         exit(0);
     }
-    // Random delay between 1–2 seconds
-    // use xor to combine the time and pid value for a better random value
-    srand(time(NULL) ^ getpid());
-    // gives a zero or one
-    int delay = 1 + rand() % 2;
-    // wait for 1–2 seconds
-    sleep(delay);
+    // Random delay between 1–2 seconds (none in fast mode)
+    if (!fast) {
+        // use xor to combine the time and pid value for a better random value
+        srand(time(NULL) ^ getpid());
+        // gives a zero or one
+        int delay = 1 + rand() % 2;
+        // wait for 1–2 seconds
+        sleep(delay);
+    }
 
     // Send the signal back with incremented volley count
     // union sigval is a structure that holds an int or pointer
     // you can send with a signal, needed for sending value with sigqueue
-    union sigval sv;
-    // increment volley count by one
-    sv.sival_int = volley + 1;
-    // sigqueue sends SIGUSR1 back to opponent with new value
-    // sigqueue(target process id, signal type, value(expects union))
-    if (sigqueue(opponent_pid, SIGUSR1, sv) == -1) {
-        perror("sigqueue"); // print system error if fails
+    // increment volley count by one; payload_encode() also stamps the send time
+    union sigval sv = payload_encode(PAYLOAD_OP_BALL, 0, (uint32_t)(volley + 1));
+    last_hit = volley + 1;
+    // peer_send queues SIGUSR1 back through the opponent's pidfd with the new value,
+    // retrying while the opponent's signal queue is full instead of dropping the ball
+    if (peer_send(&peers, opponent, SIGUSR1, sv) == -1) {
+        // ESRCH means the opponent is gone; the main loop reports that
+        if (errno != ESRCH)
+            perror("pidfd_send_signal"); // print system error if it still fails
+        return;
     }
     // otherwise print confirmation 
-    printf("\a[RECEIVER] Returned volley #%d to PID %d\n", volley + 1, opponent_pid);
+    printf("\a[SERVER] Returned volley #%d to PID %d\n", volley + 1, opponent_pid);
+}
+
+// called from peer_wait() when the opponent's pidfd reports that it exited
+static void opponent_left(struct peer_mgr *m, struct peer *p, void *arg)
+{
+    (void)m;
+    (void)arg;
+    printf("\a[SERVER] Opponent PID %d left the court. Game over!\n", p->pid);
+    opponent_gone = 1;
 }
 
 /**
@@ -113,57 +174,114 @@ void handle_ball(int signum, siginfo_t *info, void *context)
  */
 int main(int argc, char *argv[])
 {
-    // checks if you provided only one argument
-    if (argc != 2) {
-        // send an error if you forgot the PID
-        fprintf(stderr, "Usage: %s <receiver_pid>\n", argv[0]);
-        return 1;
+    // -r name finds the receiver by name instead of by PID
+    const char *court = NULL;
+    int serve_fd = -1;
+    int opt;
+    while ((opt = getopt(argc, argv, "fn:r:S:")) != -1) {
+        switch (opt) {
+        case 'f':
+            fast = 1;
+            break;
+        case 'n':
+            max_volleys = atoi(optarg);
+            break;
+        case 'r':
+            court = optarg;
+            break;
+        case 'S':
+            serve_fd = atoi(optarg);
+            break;
+        default:
+            goto usage;
+        }
+    }
+    // exactly one of a PID or a rendezvous name, and a game of at least one volley
+    if (max_volleys < 1 || (court == NULL) != (optind == argc - 1) || optind < argc - 1)
+        goto usage;
+
+    if (court == NULL) {
+        // converts the string (user input) to an int using atoi
+        opponent_pid = (pid_t)atoi(argv[optind]);
     }
 
-    // converts the string (user input) to an int using atoi
-    opponent_pid = (pid_t)atoi(argv[1]);
-
-    // declares the new sigaction
-    struct sigaction sa;
-    // clears it with all zeros
-    memset(&sa, 0, sizeof(sa));
-    // sets handler function to handle_ball
-    sa.sa_sigaction = handle_ball;
-    // makes sure the handler receives extra info (siginfo_t)
-    sa.sa_flags = SA_SIGINFO;
-
-    // whenever process receives SIGUSR1, call sa.sa_sigaction
-    if (sigaction(SIGUSR1, &sa, NULL) == -1) {
-        perror("sigaction");
+    // set up the handler -> main loop queue before any signal can arrive,
+    // and counters any scraper can read from /dev/shm (see metrics_dump)
+    sigrt_init("serve_tennis");
+
+    // open the opponent as a pidfd; this also checks the PID really exists
+    if (peer_mgr_init(&peers, 1) == -1)
         return 1;
+    peers.retry_ns = BALL_RETRY_NS;
+
+    // by name: wait (briefly) for the receiver to show up and be ready;
+    // the kernel tells us its PID through the socket
+    if (court != NULL) {
+        opponent_pid = rdv_connect(court, RDV_TIMEOUT_NS);
+        if (opponent_pid == -1) {
+            perror("rendezvous");
+            fprintf(stderr, "[SERVER] No receiver at court \"%s\"\n", court);
+            return 1;
+        }
     }
+    opponent = peer_add(&peers, opponent_pid);
+    if (opponent == -1) {
+        perror("pidfd_open");
+        fprintf(stderr, "[SERVER] No player with PID %d\n", opponent_pid);
+        return 1;
+    }
+
+    // one handler per (signal, opcode): stamped and legacy balls alike go
+    // to play_ball(), anything on SIGUSR2 ends the game
+    sigrt_on(SIGUSR1, PAYLOAD_OP_BALL, play_ball, NULL);
+    sigrt_on(SIGUSR1, PAYLOAD_OP_NONE, play_ball, NULL);
+    sigrt_on(SIGUSR2, SIGRT_ANY_OP, game_over, NULL);
 
-    // register graceful exit handler for SIGUSR2
-    struct sigaction sa_end;
-    memset(&sa_end, 0, sizeof(sa_end));
-    sa_end.sa_handler = handle_game_over;
-    sigaction(SIGUSR2, &sa_end, NULL);
+    // keep both signals blocked except while waiting in sigsuspend(),
+    // so a ball can never interrupt the one we are playing
+    sigset_t waitmask;
+    if (sigrt_start(&waitmask) == -1)
+        return 1;
 
     // confirmation print statement
     printf("[SERVER] Ready. PID: %d | Opponent PID: %d\n", getpid(), opponent_pid);
 
-    // Serve the first volley, wait one second before starting
-    sleep(1);
-    // creates a container to hold data, needed for sigqueue
-    union sigval sv;
-    // sets that integer to 1 (first volley)
-    sv.sival_int = 1;
+    // Serve the first volley, wait one second before starting (unless fast)
+    if (!fast)
+        sleep(1);
+    // volley 1, stamped with the time of the serve
+    union sigval sv = payload_encode(PAYLOAD_OP_BALL, 0, 1);
+    last_hit = 1;
     // prints that you’re serving volley #1, \a makes a beep sound
     printf("\a[SERVER] Serving volley #1 to PID %d\n", opponent_pid);
-    // sigqueue(target process id, signal type, value(expects union))
-    if (sigqueue(opponent_pid, SIGUSR1, sv) == -1) {
-        perror("sigqueue");
+    // peer_send(opponent, signal type, value(expects union)) through the pidfd,
+    // retried while the opponent's queue is full
+    if (peer_send(&peers, opponent, SIGUSR1, sv) == -1) {
+        perror("pidfd_send_signal");
+    }
+    // -S: tell the launcher when the ball went out, so it can time the setup
+    if (serve_fd >= 0) {
+        uint64_t served = mono_ns();
+        if (write(serve_fd, &served, sizeof(served)) != (ssize_t)sizeof(served))
+            perror("write serve time");
+        close(serve_fd);
     }
 
-    // puts the process to sleep until next signal arrives
-    while (1) {
-        pause();
+    // puts the process to sleep until the next signal arrives or the
+    // opponent exits, then plays every ball the handler queued
+    while (!opponent_gone) {
+        if (peer_wait(&peers, -1, &waitmask, opponent_left, NULL) == -1) {
+            perror("epoll_pwait");
+            return 1;
+        }
+        sigrt_dispatch();
+        fflush(stdout);
     }
 
+    peer_mgr_close(&peers);
     return 0;
+
+usage:
+    fprintf(stderr, "Usage: %s [-f] [-n volleys] [-S fd] <receiver_pid | -r name>\n", argv[0]);
+    return 1;
 }
@@ -0,0 +1,173 @@
+/**
+ * @file        : shm_ring.c
+ * @brief       : Single-producer/single-consumer byte ring in POSIX shared memory.
+ *
+ * Details      :
+ * - The producer publishes the new tail and then re-reads head; the consumer
+ *   publishes the new head and then re-reads tail. Both use sequentially
+ *   consistent atomics, so at least one side always sees the other's update:
+ *   either the consumer finds the new bytes, or the producer sees an empty
+ *   ring and rings the doorbell. No wakeup can be lost.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "shm_ring.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* Round up to the next power of two (minimum one page) */
+static uint32_t ring_size(uint32_t want)
+{
+    uint32_t size = 4096;
+    while (size < want && size < (1u << 30))
+        size <<= 1;
+    return size;
+}
+
+int shm_ring_create(struct shm_ring *ring, const char *name, uint32_t capacity)
+{
+    uint32_t cap = ring_size(capacity);
+    size_t len = sizeof(struct shm_ring_hdr) + cap;
+
+    shm_unlink(name); /* stale ring from an earlier run */
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd == -1) {
+        perror("shm_open");
+        return -1;
+    }
+    if (ftruncate(fd, (off_t)len) == -1) {
+        perror("ftruncate");
+        close(fd);
+        shm_unlink(name);
+        return -1;
+    }
+
+    void *map = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        perror("mmap");
+        shm_unlink(name);
+        return -1;
+    }
+
+    ring->hdr = map;
+    ring->map_len = len;
+    ring->mask = cap - 1;
+
+    ring->hdr->capacity = cap;
+    ring->hdr->consumer_pid = getpid();
+    atomic_store(&ring->hdr->head, 0);
+    atomic_store(&ring->hdr->tail, 0);
+    ring->hdr->magic = SHM_RING_MAGIC;
+    return 0;
+}
+
+int shm_ring_open(struct shm_ring *ring, const char *name)
+{
+    int fd = shm_open(name, O_RDWR, 0);
+    if (fd == -1) {
+        perror("shm_open");
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == -1 || (size_t)st.st_size < sizeof(struct shm_ring_hdr)) {
+        fprintf(stderr, "shm_ring: %s is not a ring\n", name);
+        close(fd);
+        return -1;
+    }
+
+    void *map = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        perror("mmap");
+        return -1;
+    }
+
+    ring->hdr = map;
+    ring->map_len = (size_t)st.st_size;
+    if (ring->hdr->magic != SHM_RING_MAGIC ||
+        sizeof(struct shm_ring_hdr) + ring->hdr->capacity > ring->map_len) {
+        fprintf(stderr, "shm_ring: %s is not a ring\n", name);
+        munmap(map, ring->map_len);
+        return -1;
+    }
+    ring->mask = ring->hdr->capacity - 1;
+    return 0;
+}
+
+void shm_ring_close(struct shm_ring *ring, const char *name)
+{
+    if (ring->hdr != NULL)
+        munmap(ring->hdr, ring->map_len);
+    ring->hdr = NULL;
+    if (name != NULL)
+        shm_unlink(name);
+}
+
+size_t shm_ring_write(struct shm_ring *ring, const void *buf, size_t len, int *was_empty)
+{
+    struct shm_ring_hdr *h = ring->hdr;
+    uint32_t tail = atomic_load_explicit(&h->tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&h->head, memory_order_acquire);
+    uint32_t space = h->capacity - (tail - head);
+
+    *was_empty = 0;
+    if (len > space)
+        len = space;
+    if (len == 0)
+        return 0;
+
+    /* Copy in at most two pieces around the wrap point */
+    uint32_t pos = tail & ring->mask;
+    size_t first = h->capacity - pos;
+    if (first > len)
+        first = len;
+    memcpy(h->data + pos, buf, first);
+    memcpy(h->data, (const unsigned char *)buf + first, len - first);
+
+    atomic_store(&h->tail, tail + (uint32_t)len);
+
+    /* Re-read head after publishing; see the ordering note at the top */
+    *was_empty = atomic_load(&h->head) == tail;
+    return len;
+}
+
+size_t shm_ring_read(struct shm_ring *ring, void *buf, size_t len)
+{
+    struct shm_ring_hdr *h = ring->hdr;
+    uint32_t head = atomic_load_explicit(&h->head, memory_order_relaxed);
+    uint32_t tail = atomic_load(&h->tail);
+    uint32_t avail = tail - head;
+
+    if (len > avail)
+        len = avail;
+    if (len == 0)
+        return 0;
+
+    uint32_t pos = head & ring->mask;
+    size_t first = h->capacity - pos;
+    if (first > len)
+        first = len;
+    memcpy(buf, h->data + pos, first);
+    memcpy((unsigned char *)buf + first, h->data, len - first);
+
+    atomic_store(&h->head, head + (uint32_t)len);
+    return len;
+}
+
+uint32_t shm_ring_tail(const struct shm_ring *ring)
+{
+    return atomic_load_explicit(&ring->hdr->tail, memory_order_relaxed);
+}
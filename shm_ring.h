@@ -0,0 +1,82 @@
+/**
+ * @file        : shm_ring.h
+ * @brief       : Single-producer/single-consumer byte ring in POSIX shared memory.
+ *
+ * Details      :
+ * - The receiver creates the ring with shm_open()/mmap(); the sender maps
+ *   the same name. Payload bytes are copied straight into the shared pages,
+ *   so no data travels through the kernel.
+ * - head/tail are free-running 32-bit byte counters; the capacity is a power
+ *   of two so (index & mask) gives the position in the buffer.
+ * - Signals are only a doorbell: shm_ring_write() reports when the consumer
+ *   had drained the ring, and only then does the sender sigqueue() a wakeup
+ *   whose sival_int is the new tail index.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#ifndef SHM_RING_H
+#define SHM_RING_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#define SHM_RING_MAGIC 0x52494e47u /* "RING" */
+
+/** Shared header; the data area follows it in the same mapping */
+struct shm_ring_hdr
+{
+    uint32_t magic;
+    uint32_t capacity;                 /* bytes, power of two */
+    pid_t consumer_pid;                /* where doorbells are sent */
+    _Alignas(64) _Atomic uint32_t tail; /* written by the producer */
+    _Alignas(64) _Atomic uint32_t head; /* written by the consumer */
+    _Alignas(64) unsigned char data[];
+};
+
+/** Process-local handle to a mapped ring */
+struct shm_ring
+{
+    struct shm_ring_hdr *hdr;
+    size_t map_len;
+    uint32_t mask;
+};
+
+/**
+ * @brief Create (or replace) ring @p name with at least @p capacity bytes.
+ *        The caller becomes the consumer.
+ * @return 0 on success, -1 on failure.
+ */
+int shm_ring_create(struct shm_ring *ring, const char *name, uint32_t capacity);
+
+/** @brief Map an existing ring as the producer. @return 0 or -1. */
+int shm_ring_open(struct shm_ring *ring, const char *name);
+
+/** @brief Unmap the ring (and unlink @p name when non-NULL). */
+void shm_ring_close(struct shm_ring *ring, const char *name);
+
+/**
+ * @brief Producer: copy up to @p len bytes into the ring.
+ *
+ * @param was_empty Set to 1 when the consumer had caught up with the old
+ *                  tail, i.e. a doorbell must be rung for these bytes.
+ * @return Bytes written (0 when the ring is full).
+ */
+size_t shm_ring_write(struct shm_ring *ring, const void *buf, size_t len, int *was_empty);
+
+/**
+ * @brief Consumer: copy up to @p len bytes out of the ring.
+ * @return Bytes read (0 when the ring is empty).
+ */
+size_t shm_ring_read(struct shm_ring *ring, void *buf, size_t len);
+
+/** @brief Current producer index (the value carried by a doorbell). */
+uint32_t shm_ring_tail(const struct shm_ring *ring);
+
+#endif /* SHM_RING_H */
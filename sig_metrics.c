@@ -0,0 +1,269 @@
+/**
+ * @file        : sig_metrics.c
+ * @brief       : Shared-memory signal metrics page: recording, snapshots and readers.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "sig_metrics.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "latency_hist.h"
+
+_Static_assert(sizeof(struct sm_counters) % 64 == 0, "signal counters share a cache line");
+
+/* This process's page; NULL turns every recording call into a no-op */
+static struct sm_page *page;
+static char page_path[PATH_MAX];
+
+/* Set while a snapshot is copied, so two threads never interleave copies */
+static atomic_flag copying = ATOMIC_FLAG_INIT;
+
+static void snapshot_handler(int signum)
+{
+    (void)signum;
+    sm_snapshot();
+}
+
+int sm_open(const char *program)
+{
+    if (page != NULL)
+        return 0;
+
+    snprintf(page_path, sizeof(page_path), SIG_METRICS_DIR "/" SIG_METRICS_PREFIX "%s.%d",
+             program, (int)getpid());
+    /* The name is predictable and /dev/shm is world-writable: remove a page
+       left by an earlier process with this PID, then only ever create a
+       fresh file, never open (and truncate) whatever someone planted there */
+    if (unlink(page_path) == -1 && errno != ENOENT) {
+        perror(page_path);
+        return -1;
+    }
+    int fd = open(page_path, O_RDWR | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC, 0644);
+    if (fd == -1) {
+        perror(page_path);
+        return -1;
+    }
+    if (ftruncate(fd, (off_t)sizeof(struct sm_page)) == -1) {
+        perror("ftruncate");
+        close(fd);
+        unlink(page_path);
+        return -1;
+    }
+    void *map = mmap(NULL, sizeof(struct sm_page), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        perror("mmap");
+        unlink(page_path);
+        return -1;
+    }
+
+    /* A fresh file is all zeros, which is every counter's start value */
+    struct sm_page *p = map;
+    p->version = SIG_METRICS_VERSION;
+    p->pid = getpid();
+    p->start_ns = mono_ns();
+    p->snapshot_signo = sm_snapshot_signal();
+    snprintf(p->program, sizeof(p->program), "%s", program);
+    /* Readers check the magic before anything else */
+    atomic_thread_fence(memory_order_release);
+    p->magic = SIG_METRICS_MAGIC;
+    page = p;
+
+    /* Copy with everything else blocked: no handler can run halfway through */
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = snapshot_handler;
+    sa.sa_flags = SA_RESTART;
+    sigfillset(&sa.sa_mask);
+    if (sigaction(sm_snapshot_signal(), &sa, NULL) == -1)
+        perror("sigaction");
+
+    atexit(sm_close);
+    return 0;
+}
+
+void sm_handled(int signo, uint64_t start_ns)
+{
+    if (page == NULL || signo <= 0 || signo >= SIG_METRICS_SIGNALS)
+        return;
+
+    struct sm_counters *c = &page->live.sig[signo];
+    uint64_t ns = mono_ns() - start_ns;
+    unsigned b = ns == 0 ? 0 : 63u - (unsigned)__builtin_clzll(ns);
+    if (b >= SIG_METRICS_BUCKETS)
+        b = SIG_METRICS_BUCKETS - 1;
+
+    atomic_fetch_add_explicit(&c->handled, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&c->handle_ns, ns, memory_order_relaxed);
+    atomic_fetch_add_explicit(&c->buckets[b], 1, memory_order_relaxed);
+    uint64_t max = atomic_load_explicit(&c->handle_max_ns, memory_order_relaxed);
+    while (ns > max &&
+           !atomic_compare_exchange_weak_explicit(&c->handle_max_ns, &max, ns,
+                                                  memory_order_relaxed, memory_order_relaxed))
+        ;
+}
+
+void sm_queue_full(int signo)
+{
+    if (page != NULL && signo > 0 && signo < SIG_METRICS_SIGNALS)
+        atomic_fetch_add_explicit(&page->live.sig[signo].queue_full, 1, memory_order_relaxed);
+}
+
+void sm_dropped(int signo)
+{
+    if (page != NULL && signo > 0 && signo < SIG_METRICS_SIGNALS)
+        atomic_fetch_add_explicit(&page->live.sig[signo].dropped, 1, memory_order_relaxed);
+}
+
+/* Counter by counter; relaxed loads/stores, ordering comes from the sequence lock */
+static void copy_block(struct sm_block *dst, const struct sm_block *src)
+{
+    for (int s = 0; s < SIG_METRICS_SIGNALS; s++) {
+        const struct sm_counters *from = &src->sig[s];
+        struct sm_counters *to = &dst->sig[s];
+        atomic_store_explicit(&to->handled, atomic_load_explicit(&from->handled, memory_order_relaxed),
+                              memory_order_relaxed);
+        atomic_store_explicit(&to->handle_ns, atomic_load_explicit(&from->handle_ns, memory_order_relaxed),
+                              memory_order_relaxed);
+        atomic_store_explicit(&to->handle_max_ns,
+                              atomic_load_explicit(&from->handle_max_ns, memory_order_relaxed),
+                              memory_order_relaxed);
+        atomic_store_explicit(&to->queue_full, atomic_load_explicit(&from->queue_full, memory_order_relaxed),
+                              memory_order_relaxed);
+        atomic_store_explicit(&to->dropped, atomic_load_explicit(&from->dropped, memory_order_relaxed),
+                              memory_order_relaxed);
+        for (int b = 0; b < SIG_METRICS_BUCKETS; b++)
+            atomic_store_explicit(&to->buckets[b],
+                                  atomic_load_explicit(&from->buckets[b], memory_order_relaxed),
+                                  memory_order_relaxed);
+    }
+}
+
+void sm_snapshot(void)
+{
+    if (page == NULL || atomic_flag_test_and_set(&copying))
+        return; /* one copy at a time; the one in progress is just as recent */
+
+    uint64_t seq = atomic_load_explicit(&page->seq, memory_order_relaxed);
+    atomic_store_explicit(&page->seq, seq + 1, memory_order_relaxed);
+    /* The odd sequence becomes visible before any of the copy does */
+    atomic_thread_fence(memory_order_release);
+
+    copy_block(&page->snap, &page->live);
+    atomic_store_explicit(&page->snap_ns, mono_ns(), memory_order_relaxed);
+    atomic_fetch_add_explicit(&page->snapshots, 1, memory_order_relaxed);
+
+    atomic_store_explicit(&page->seq, seq + 2, memory_order_release);
+    atomic_flag_clear(&copying);
+}
+
+int sm_snapshot_signal(void)
+{
+    return SIGRTMAX - 1;
+}
+
+const char *sm_path(void)
+{
+    return page != NULL ? page_path : NULL;
+}
+
+void sm_close(void)
+{
+    if (page == NULL)
+        return;
+    /* A forked child shares the mapping but does not own the file */
+    if (page->pid == getpid())
+        unlink(page_path);
+    munmap(page, sizeof(struct sm_page));
+    page = NULL;
+}
+
+const struct sm_page *sm_map(const char *path)
+{
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        perror(path);
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == -1 || (size_t)st.st_size != sizeof(struct sm_page)) {
+        fprintf(stderr, "%s: not a metrics page (or a different version)\n", path);
+        close(fd);
+        return NULL;
+    }
+    void *map = mmap(NULL, sizeof(struct sm_page), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        perror("mmap");
+        return NULL;
+    }
+
+    const struct sm_page *p = map;
+    if (p->magic != SIG_METRICS_MAGIC || p->version != SIG_METRICS_VERSION) {
+        fprintf(stderr, "%s: not a metrics page (or a different version)\n", path);
+        munmap(map, sizeof(struct sm_page));
+        return NULL;
+    }
+    atomic_thread_fence(memory_order_acquire);
+    return p;
+}
+
+uint64_t sm_read_snapshot(const struct sm_page *p, struct sm_block *out)
+{
+    /* Casting away const only for the atomic loads; nothing is written */
+    struct sm_page *rp = (struct sm_page *)p;
+    for (;;) {
+        uint64_t before = atomic_load_explicit(&rp->seq, memory_order_acquire);
+        if (before & 1)
+            continue; /* being copied right now */
+        copy_block(out, &rp->snap);
+        uint64_t count = atomic_load_explicit(&rp->snapshots, memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&rp->seq, memory_order_relaxed) == before)
+            return count;
+    }
+}
+
+void sm_read_live(const struct sm_page *p, struct sm_block *out)
+{
+    copy_block(out, &((struct sm_page *)p)->live);
+}
+
+uint64_t sm_percentile(const struct sm_counters *c, double pct)
+{
+    uint64_t total = atomic_load_explicit(&c->handled, memory_order_relaxed);
+    if (total == 0)
+        return 0;
+    uint64_t rank = (uint64_t)(pct / 100.0 * (double)total);
+    if (rank >= total)
+        rank = total - 1;
+
+    uint64_t seen = 0;
+    for (int b = 0; b < SIG_METRICS_BUCKETS; b++) {
+        seen += atomic_load_explicit(&c->buckets[b], memory_order_relaxed);
+        if (seen > rank)
+            return (2ull << b) - 1;
+    }
+    return atomic_load_explicit(&c->handle_max_ns, memory_order_relaxed);
+}
+
+void sm_unmap(const struct sm_page *p)
+{
+    munmap((void *)p, sizeof(struct sm_page));
+}
@@ -0,0 +1,138 @@
+/**
+ * @file        : sig_metrics.h
+ * @brief       : Per-process signal metrics in a shared mmap'd page, with on-demand snapshots.
+ *
+ * Details      :
+ * - sm_open() creates SIG_METRICS_DIR/sig_metrics.<program>.<pid> (tmpfs,
+ *   so nothing ever goes to disk) and maps it shared. Any other process can
+ *   map the same file read-only and read the counters with plain loads: no
+ *   syscall to, and no cooperation from, the measured process.
+ * - Per signal number: signals handled, time spent handling them (total,
+ *   max and a log2 histogram), sends of that signal refused with EAGAIN
+ *   (queue full) and signals dropped because the handler queue was full.
+ *   Each signal's counters start on their own cache line, so handlers for
+ *   different signals in different threads never share one.
+ * - Recording is one or two relaxed atomic adds into the mapping:
+ *   async-signal-safe, lock-free and safe from several threads. With no
+ *   page open every call is a single NULL check.
+ * - Live counters move while they are read. sm_snapshot() copies all of
+ *   them into a second block under a sequence lock (odd while copying); the
+ *   snapshot signal (SIGRTMAX - 1, installed by sm_open()) runs it with
+ *   every other signal blocked, so in a single-threaded program the copy is
+ *   exactly the state between two handlers, and a reader never sees a
+ *   half-written copy. signal_handler also takes one on SIGINT.
+ * - sm_close() (registered with atexit() by sm_open()) removes the file;
+ *   metrics_dump -x cleans up after processes that were killed.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#ifndef SIG_METRICS_H
+#define SIG_METRICS_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+#define SIG_METRICS_MAGIC   0x435254454d474953ULL  /* "SIGMETRC" */
+#define SIG_METRICS_VERSION 1
+#define SIG_METRICS_DIR     "/dev/shm"
+#define SIG_METRICS_PREFIX  "sig_metrics."
+
+/* Signal numbers 1..64 are indexed directly; 0 is unused */
+#define SIG_METRICS_SIGNALS 65
+
+/* Handling time histogram: bucket b counts times in [2^b, 2^(b+1)) ns */
+#define SIG_METRICS_BUCKETS 32
+
+/** Counters of one signal number */
+struct sm_counters
+{
+    _Alignas(64) _Atomic uint64_t handled;
+    _Atomic uint64_t handle_ns;         /* total time in the handler / consumer */
+    _Atomic uint64_t handle_max_ns;
+    _Atomic uint64_t queue_full;        /* sends of this signal refused with EAGAIN */
+    _Atomic uint64_t dropped;           /* received, but the handler queue was full */
+    _Atomic uint64_t buckets[SIG_METRICS_BUCKETS];
+};
+
+/** Counters of every signal */
+struct sm_block
+{
+    struct sm_counters sig[SIG_METRICS_SIGNALS];
+};
+
+/** The shared page: header, sequence lock, live counters, last snapshot */
+struct sm_page
+{
+    uint64_t magic;                     /* written last by sm_open() */
+    uint32_t version;
+    int32_t pid;
+    uint64_t start_ns;                  /* CLOCK_MONOTONIC at sm_open() */
+    int32_t snapshot_signo;
+    uint32_t reserved;
+    char program[32];
+
+    _Alignas(64) _Atomic uint64_t seq;  /* odd while a snapshot is being copied */
+    _Atomic uint64_t snapshots;         /* snapshots taken so far */
+    _Atomic uint64_t snap_ns;           /* CLOCK_MONOTONIC of the last snapshot */
+
+    struct sm_block live;
+    struct sm_block snap;
+};
+
+/**
+ * @brief Create the metrics page for this process and install the snapshot
+ *        signal handler. Failure is reported but harmless: recording then
+ *        does nothing.
+ * @return 0 on success, -1 on failure (message printed).
+ */
+int sm_open(const char *program);
+
+/** @brief Count one @p signo handled since @p start_ns (mono_ns()). Async-signal-safe. */
+void sm_handled(int signo, uint64_t start_ns);
+
+/** @brief Count one send of @p signo refused with EAGAIN. Async-signal-safe. */
+void sm_queue_full(int signo);
+
+/** @brief Count one @p signo lost to a full handler queue. Async-signal-safe. */
+void sm_dropped(int signo);
+
+/** @brief Copy the live counters into the snapshot block. Async-signal-safe. */
+void sm_snapshot(void);
+
+/** @brief The signal that triggers sm_snapshot() (SIGRTMAX - 1). */
+int sm_snapshot_signal(void);
+
+/** @brief Path of this process's page, or NULL when none is open. */
+const char *sm_path(void);
+
+/** @brief Unmap and remove this process's page. */
+void sm_close(void);
+
+/**
+ * @brief Map someone's page read-only.
+ * @return The page, or NULL on failure (message printed).
+ */
+const struct sm_page *sm_map(const char *path);
+
+/**
+ * @brief Consistent copy of the last snapshot of @p page (retried while a
+ *        snapshot is being written).
+ * @return The snapshot count the copy belongs to.
+ */
+uint64_t sm_read_snapshot(const struct sm_page *page, struct sm_block *out);
+
+/** @brief Copy of the live counters (each counter exact, not all from the same instant). */
+void sm_read_live(const struct sm_page *page, struct sm_block *out);
+
+/** @brief Upper bound of the @p pct percentile of @p c's handling time, in ns. */
+uint64_t sm_percentile(const struct sm_counters *c, double pct);
+
+/** @brief Unmap a page from sm_map(). */
+void sm_unmap(const struct sm_page *page);
+
+#endif /* SIG_METRICS_H */
@@ -0,0 +1,239 @@
+/**
+ * @file        : sig_replay.c
+ * @brief       : Re-sends a binary signal trace (sig_trace.c) to a target process.
+ *
+ * Details      :
+ * - Reads a trace written by recv_signal -t, recv_tennis -t or
+ *   signal_sigaction -t and queues every recorded signal, with its recorded
+ *   si_value, to the target PID. The same trace always produces the same
+ *   traffic, so a load problem seen once can be reproduced at will.
+ * - By default each signal is sent at its original offset from the first
+ *   record (clock_nanosleep(TIMER_ABSTIME) deadlines, open loop), optionally
+ *   sped up or slowed down (-x). -f sends back to back as fast as possible.
+ * - The target is held as a pidfd (peer_mgr.c); a full pending queue
+ *   (EAGAIN) is retried for up to a second before the signal counts as lost,
+ *   and replay stops as soon as the target exits.
+ * - Every signal arrives from this process with SI_QUEUE, whatever sender
+ *   and si_code it had originally. Credit hellos (FLOW_ACK_SIGNAL) are
+ *   skipped: the replayer is not a flow-controlled sender.
+ * - Structured payloads (payload.h) are re-stamped with the time they are
+ *   replayed, so the receiver's one-way latency measures the replay, not
+ *   the age of the trace; opcode, channel and sequence are kept.
+ * - -p prints the trace as text instead of replaying it.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ *
+ * Compile      : make sig_replay
+ * Usage        : ./sig_replay [-f] [-x speed] [-l loops] <trace> <pid>
+ *                ./sig_replay -p <trace>
+ *                  -f  as fast as possible (ignore the recorded timing)
+ *                  -x  timing multiplier: 2 replays twice as fast (default 1)
+ *                  -l  replay the trace this many times back to back
+ *                  -p  print the records instead of sending them
+ * Example      : ./recv_signal -r -q -t load.trace     (record, Ctrl+C to stop)
+ *                ./sig_replay load.trace 12345         (same traffic, same timing)
+ *                ./sig_replay -f -l 10 load.trace 12345
+ *
+ * Algorithm
+ *  - Map the trace read-only; skip unfinished records (signo still 0).
+ *  - Record i of loop k is due at start + (k * span + ts_i - ts_0) / speed.
+ *  - Sleep until it is due (unless -f), send it through the pidfd and
+ *    record how far behind schedule the send completed.
+ *  - Print sent/lost counts, achieved rate and the lateness histogram.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/prctl.h>
+
+#include "sig_trace.h"
+#include "peer_mgr.h"
+#include "latency_hist.h"
+#include "payload.h"
+#include "flow_ctl.h"
+
+/* How long one signal may keep hitting a full queue before it counts as lost */
+#define REPLAY_RETRY_NS 1000000000ULL
+
+/* Print the trace as text, one record per line */
+static void print_trace(const struct sig_trace *t)
+{
+    uint64_t n = st_count(t);
+    uint64_t first = 0;
+
+    printf("# %llu records from PID %d (%llu dropped while recording)\n",
+           (unsigned long long)n, t->hdr->recorder_pid, (unsigned long long)st_dropped(t));
+    printf("# t_us signo pid code value payload(op/channel/seq)\n");
+    for (uint64_t i = 0; i < n; i++) {
+        const struct sig_trace_rec *r = &t->recs[i];
+        if (r->signo == 0)
+            continue;
+        if (first == 0)
+            first = r->ts_ns;
+        struct payload p;
+        printf("%.3f %d %d %d %lld", (r->ts_ns - first) / 1e3, r->signo, r->pid, r->code,
+               (long long)r->value);
+        if (payload_decode(r->value, &p) == 0)
+            printf(" %s/%u/%u\n", payload_op_name(p.op), p.channel, p.seq);
+        else
+            printf(" -\n");
+    }
+}
+
+/* Absolute CLOCK_MONOTONIC time @p ns */
+static struct timespec ns_timespec(uint64_t ns)
+{
+    struct timespec ts = { (time_t)(ns / 1000000000ull), (long)(ns % 1000000000ull) };
+    return ts;
+}
+
+/* Time span covered by the trace (first to last finished record) */
+static uint64_t trace_span(const struct sig_trace *t, uint64_t *first)
+{
+    uint64_t lo = 0, hi = 0;
+    for (uint64_t i = 0; i < st_count(t); i++) {
+        const struct sig_trace_rec *r = &t->recs[i];
+        if (r->signo == 0)
+            continue;
+        if (lo == 0 || r->ts_ns < lo)
+            lo = r->ts_ns;
+        if (r->ts_ns > hi)
+            hi = r->ts_ns;
+    }
+    *first = lo;
+    return hi - lo;
+}
+
+static int replay(const struct sig_trace *t, pid_t pid, int fast, double speed, int loops)
+{
+    static struct latency_hist lateness;
+    static struct peer_mgr peers;
+    hist_init(&lateness);
+
+    if (peer_mgr_init(&peers, 1) == -1)
+        return 1;
+    int target = peer_add(&peers, pid);
+    if (target == -1) {
+        fprintf(stderr, "PID %d: %s\n", pid, strerror(errno));
+        peer_mgr_close(&peers);
+        return 1;
+    }
+    peers.retry_ns = REPLAY_RETRY_NS;
+
+    uint64_t first;
+    uint64_t span = trace_span(t, &first);
+    uint64_t n = st_count(t);
+    unsigned long long sent = 0, lost = 0, skipped = 0;
+    int gone = 0;
+
+    /* The default 50 us timer slack would blur the recorded spacing */
+    prctl(PR_SET_TIMERSLACK, 1UL, 0UL, 0UL, 0UL);
+
+    printf("Replaying %llu records (%.3f s recorded) x%d to PID %d %s...\n",
+           (unsigned long long)n, span / 1e9, loops, pid, fast ? "as fast as possible" : "at recorded timing");
+    fflush(stdout);
+
+    uint64_t start = mono_ns();
+    for (int k = 0; k < loops && !gone; k++) {
+        for (uint64_t i = 0; i < n; i++) {
+            const struct sig_trace_rec *r = &t->recs[i];
+            if (r->signo == 0 || r->signo == FLOW_ACK_SIGNAL) {
+                skipped++;
+                continue;
+            }
+
+            /* Open loop: the deadline comes from the trace, not from earlier sends */
+            uint64_t due_ns = start;
+            if (!fast) {
+                due_ns += (uint64_t)(((double)k * span + (double)(r->ts_ns - first)) / speed);
+                struct timespec due = ns_timespec(due_ns);
+                while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &due, NULL) == EINTR)
+                    ;
+            }
+
+            union sigval value;
+            value.sival_ptr = (void *)(uintptr_t)r->value;
+            struct payload p;
+            if (payload_decode(r->value, &p) == 0)
+                value = payload_encode(p.op, p.channel, p.seq);
+            if (peer_send(&peers, target, r->signo, value) == 0) {
+                sent++;
+            } else if (errno == ESRCH) {
+                gone = 1;
+                break;
+            } else {
+                lost++;
+            }
+            if (!fast)
+                hist_record(&lateness, mono_ns() - due_ns);
+        }
+    }
+
+    double secs = (mono_ns() - start) / 1e9;
+    if (gone)
+        printf("PID %d exited; replay stopped\n", pid);
+    printf("Replayed %llu signals in %.3f s (%.0f msg/s): %llu lost to a full queue, %llu skipped\n",
+           sent, secs, secs > 0 ? sent / secs : 0.0, lost, skipped);
+    if (!fast)
+        hist_print(&lateness, "Send lateness (from recorded time)", stdout);
+
+    peer_mgr_close(&peers);
+    return lost > 0 || gone;
+}
+
+int main(int argc, char *argv[])
+{
+    int fast = 0;
+    int print = 0;
+    int loops = 1;
+    double speed = 1.0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "fx:l:p")) != -1) {
+        switch (opt) {
+        case 'f':
+            fast = 1;
+            break;
+        case 'x':
+            speed = atof(optarg);
+            break;
+        case 'l':
+            loops = atoi(optarg);
+            break;
+        case 'p':
+            print = 1;
+            break;
+        default:
+            goto usage;
+        }
+    }
+    if (speed <= 0 || loops < 1 || optind >= argc || (!print && optind + 2 != argc))
+        goto usage;
+
+    struct sig_trace trace;
+    if (st_open(&trace, argv[optind]) == -1)
+        return 1;
+
+    int status = 0;
+    if (print)
+        print_trace(&trace);
+    else
+        status = replay(&trace, (pid_t)atoi(argv[optind + 1]), fast, speed, loops);
+    st_close(&trace);
+    return status;
+
+usage:
+    fprintf(stderr, "Usage: %s [-f] [-x speed] [-l loops] <trace> <pid>\n"
+                    "       %s -p <trace>\n", argv[0], argv[0]);
+    return 1;
+}
@@ -0,0 +1,157 @@
+/**
+ * @file        : sig_router.c
+ * @brief       : Shared shard table and rt_tgsigqueueinfo()-based thread-directed sends.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE /* syscall() */
+#include "sig_router.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+#include "cpu_affinity.h"
+
+static pid_t current_tid(void)
+{
+    return (pid_t)syscall(SYS_gettid);
+}
+
+int router_create(struct sig_router *r, const char *name, int nshards, enum route_key key)
+{
+    memset(r, 0, sizeof(*r));
+    if (nshards < 1 || nshards > ROUTE_MAX_SHARDS) {
+        fprintf(stderr, "router: 1..%d shards\n", ROUTE_MAX_SHARDS);
+        return -1;
+    }
+
+    shm_unlink(name); /* stale table from an earlier run */
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd == -1) {
+        perror("shm_open");
+        return -1;
+    }
+    if (ftruncate(fd, sizeof(struct route_table)) == -1) {
+        perror("ftruncate");
+        close(fd);
+        shm_unlink(name);
+        return -1;
+    }
+    struct route_table *t = mmap(NULL, sizeof(*t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (t == MAP_FAILED) {
+        perror("mmap");
+        shm_unlink(name);
+        return -1;
+    }
+
+    t->tgid = getpid();
+    t->nshards = nshards;
+    t->key = key;
+    for (int i = 0; i < ROUTE_MAX_SHARDS; i++) {
+        atomic_store(&t->tids[i], 0);
+        t->cpus[i] = -1;
+    }
+    t->magic = ROUTE_MAGIC;
+    r->table = t;
+    return 0;
+}
+
+int router_register(struct sig_router *r, int shard, int cpu)
+{
+    if (shard < 0 || shard >= r->table->nshards) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (cpu >= 0 && pin_thread_to_cpu(cpu) == -1)
+        return -1;
+    r->table->cpus[shard] = cpu >= 0 ? cpu % online_cpus() : -1;
+    atomic_store_explicit(&r->table->tids[shard], current_tid(), memory_order_release);
+    return 0;
+}
+
+void router_unregister(struct sig_router *r, int shard)
+{
+    if (shard >= 0 && shard < r->table->nshards)
+        atomic_store_explicit(&r->table->tids[shard], 0, memory_order_release);
+}
+
+int router_open(struct sig_router *r, const char *name)
+{
+    memset(r, 0, sizeof(*r));
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd == -1) {
+        perror("shm_open");
+        return -1;
+    }
+    struct route_table *t = mmap(NULL, sizeof(*t), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (t == MAP_FAILED) {
+        perror("mmap");
+        return -1;
+    }
+    if (t->magic != ROUTE_MAGIC) {
+        fprintf(stderr, "%s: not a routing table\n", name);
+        munmap(t, sizeof(*t));
+        return -1;
+    }
+    r->table = t;
+    return 0;
+}
+
+int router_shard(const struct sig_router *r, int channel, union sigval value)
+{
+    uint32_t k = r->table->key == ROUTE_BY_VALUE ? (uint32_t)value.sival_int : (uint32_t)channel;
+    return (int)(k % (uint32_t)r->table->nshards);
+}
+
+int router_send(struct sig_router *r, int signo, int channel, union sigval value)
+{
+    const struct route_table *t = r->table;
+    pid_t tid = atomic_load_explicit(&t->tids[router_shard(r, channel, value)],
+                                     memory_order_acquire);
+
+    if (tid != 0) {
+        /* Same siginfo sigqueue() would build; accepted because si_code < 0 */
+        siginfo_t info;
+        memset(&info, 0, sizeof(info));
+        info.si_signo = signo;
+        info.si_code = SI_QUEUE;
+        info.si_pid = getpid();
+        info.si_uid = getuid();
+        info.si_value = value;
+        if (syscall(SYS_rt_tgsigqueueinfo, t->tgid, tid, signo, &info) == 0) {
+            r->routed++;
+            return 0;
+        }
+        if (errno != ESRCH)
+            return -1;
+        /* The owner exited but the process lives on: let any thread take it */
+    }
+
+    if (sigqueue(t->tgid, signo, value) == -1)
+        return -1;
+    r->fallback++;
+    return 0;
+}
+
+void router_close(struct sig_router *r, const char *name)
+{
+    if (r->table != NULL)
+        munmap(r->table, sizeof(*r->table));
+    r->table = NULL;
+    if (name != NULL)
+        shm_unlink(name);
+}
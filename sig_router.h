@@ -0,0 +1,99 @@
+/**
+ * @file        : sig_router.h
+ * @brief       : Thread-directed signal routing: shard table in shared memory, rt_tgsigqueueinfo() sends.
+ *
+ * Details      :
+ * - A multi-threaded receiver splits its work into shards, one per worker
+ *   thread, each worker pinned to its own CPU. It publishes which thread
+ *   (TID) owns which shard in a small shm_open() table.
+ * - Senders map the table and route each message by its channel or by
+ *   sival_int to the shard's owner with rt_tgsigqueueinfo(), so it is queued
+ *   on that one thread instead of the whole process. The kernel then wakes
+ *   the thread that owns the shard's data, on its own core, instead of
+ *   whichever thread it picks for a process-directed signal.
+ * - The siginfo is the SI_QUEUE one sigqueue() would build, so receivers
+ *   see the same si_value/si_pid either way.
+ * - Shards whose thread has not registered (or has exited) fall back to a
+ *   process-directed sigqueue(), so no message is lost while routes change.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#ifndef SIG_ROUTER_H
+#define SIG_ROUTER_H
+
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#define ROUTE_MAGIC 0x45545552u /* "RUTE" */
+
+/* Most shards (worker threads) one table can describe */
+#define ROUTE_MAX_SHARDS 256
+
+/** What a message is routed by */
+enum route_key
+{
+    ROUTE_BY_CHANNEL,   /* shard = channel % shards */
+    ROUTE_BY_VALUE      /* shard = sival_int % shards */
+};
+
+/** The shared routing table */
+struct route_table
+{
+    uint32_t magic;
+    pid_t tgid;                             /* receiving process */
+    int32_t nshards;
+    int32_t key;                            /* enum route_key */
+    _Atomic int32_t tids[ROUTE_MAX_SHARDS]; /* owner thread, 0 = not registered */
+    int32_t cpus[ROUTE_MAX_SHARDS];         /* CPU the owner is pinned to, -1 = none */
+};
+
+/** Process-local handle */
+struct sig_router
+{
+    struct route_table *table;
+    uint64_t routed;    /* messages sent thread-directed */
+    uint64_t fallback;  /* messages sent process-directed (no owner) */
+};
+
+/**
+ * @brief Receiver: create (or replace) table @p name for @p nshards shards.
+ * @return 0 on success, -1 on failure (message printed).
+ */
+int router_create(struct sig_router *r, const char *name, int nshards, enum route_key key);
+
+/**
+ * @brief Receiver: make the calling thread the owner of @p shard and, when
+ *        @p cpu >= 0, pin it to that CPU.
+ * @return 0 on success, -1 on failure.
+ */
+int router_register(struct sig_router *r, int shard, int cpu);
+
+/** @brief Receiver: withdraw the calling thread's route for @p shard. */
+void router_unregister(struct sig_router *r, int shard);
+
+/**
+ * @brief Sender: map the existing table @p name.
+ * @return 0 on success, -1 on failure (message printed).
+ */
+int router_open(struct sig_router *r, const char *name);
+
+/** @brief Shard a message with @p channel and @p value belongs to. */
+int router_shard(const struct sig_router *r, int channel, union sigval value);
+
+/**
+ * @brief Queue @p signo with @p value on the thread that owns the message's shard.
+ * @return 0 on success, -1 on failure (errno set; EAGAIN when its queue is full).
+ */
+int router_send(struct sig_router *r, int signo, int channel, union sigval value);
+
+/** @brief Unmap the table (and unlink @p name when non-NULL). */
+void router_close(struct sig_router *r, const char *name);
+
+#endif /* SIG_ROUTER_H */
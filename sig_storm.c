@@ -0,0 +1,421 @@
+/**
+ * @file        : sig_storm.c
+ * @brief       : Signal storm stress test — M senders, one receiver, rising rates, CSV results.
+ *
+ * Details      :
+ * - Forks a receiver that drains SIGUSR1 and one real-time channel signal
+ *   per sender from a signalfd in batches, like recv_signal -f.
+ * - Each step forks M senders that together offer a fixed rate (open loop,
+ *   absolute clock_nanosleep() deadlines), mixing SIGUSR1 (-u percent) with
+ *   real-time signals. Every message carries a structured payload
+ *   (payload.h): channel = sender index, a per-sender, per-kind sequence
+ *   number and the send time.
+ * - A sender only advances its sequence when sigqueue() succeeds, so the
+ *   accounting is exact:
+ *     eagain     sigqueue() refused it (RLIMIT_SIGPENDING reached)
+ *     delivered  the receiver read it
+ *     coalesced  accepted SIGUSR1 that never arrived (merged while pending)
+ *     lost       accepted real-time signal that never arrived (should be 0)
+ *     seq_gaps   sequence numbers the receiver saw skipped, both kinds: the
+ *                same loss seen from the receiving end, message by message
+ *     reordered  arrived after a later sequence number from the same stream
+ *     no_payload arrived without its siginfo (a standard signal queued when
+ *                the pending limit was reached carries no si_value)
+ * - The rate grows by -g per step from -r up to -R. The knee is the last
+ *   step whose delivered rate is still KNEE_EFFICIENCY of the offered rate;
+ *   the sweep stops STEPS_PAST_KNEE steps after it.
+ * - Results go to stdout as CSV, one row per step with a knee column, so
+ *   runs before and after a kernel or limit change can be diffed; progress
+ *   goes to stderr.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ *
+ * Compile      : make sig_storm
+ * Usage        : ./sig_storm [-m senders] [-r start_rate] [-R max_rate] [-g growth]
+ *                            [-d step_seconds] [-u usr1_percent]
+ * Example      : ./sig_storm -m 8 -r 5000 -R 2000000 -g 2 -d 0.5 -u 25 > storm.csv
+ *
+ * Algorithm
+ *  1. Map the shared counters, block the signals and fork the receiver.
+ *  2. For each rate: snapshot the counters, fork M senders at rate / M,
+ *     reap them, wait until the receiver has been idle for DRAIN_QUIET_NS.
+ *  3. The counter deltas give the step's row; reset the latency histogram.
+ *  4. Stop the receiver with SIGUSR2, find the knee and print the CSV.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE /* MAP_ANONYMOUS */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/signalfd.h>
+#include <sys/wait.h>
+
+#include "latency_hist.h"
+#include "payload.h"
+#include "rt_channel.h"
+
+#define DEFAULT_SENDERS   4
+#define DEFAULT_START     1000.0
+#define DEFAULT_MAX       1024000.0
+#define DEFAULT_GROWTH    2.0
+#define DEFAULT_STEP_SECS 0.5
+#define DEFAULT_USR1_PCT  25
+
+/* One payload channel per sender */
+#define MAX_SENDERS ((int)PAYLOAD_CHAN_MASK + 1)
+#define MAX_STEPS   64
+
+/* Delivered / offered at or above this is "keeping up" */
+#define KNEE_EFFICIENCY 0.90
+#define STEPS_PAST_KNEE 2
+
+/* The receiver is drained once nothing arrived for this long (or after DRAIN_MAX_NS) */
+#define DRAIN_QUIET_NS 50000000ULL
+#define DRAIN_MAX_NS   5000000000ULL
+
+#define SIGFD_BATCH 64
+
+enum kind { USR1, RT, KINDS };
+
+/** Counters of one sender, written only by that sender's process */
+struct storm_sender
+{
+    _Alignas(64) uint64_t attempted[KINDS];
+    uint64_t sent[KINDS];
+    uint64_t eagain[KINDS];
+    uint32_t seq[KINDS];        /* next sequence number, carried across steps */
+};
+
+/** Counters of the receiver, polled by the driver */
+struct storm_receiver
+{
+    _Alignas(64) _Atomic uint64_t delivered[KINDS];
+    _Atomic uint64_t missing[KINDS];    /* sequence numbers skipped */
+    _Atomic uint64_t reordered[KINDS];
+    _Atomic uint64_t no_payload[KINDS];
+    _Atomic uint64_t last_ns;           /* time of the latest delivery */
+    struct latency_hist latency;        /* send -> read, reset every step */
+};
+
+/** One CSV row */
+struct step_result
+{
+    double offered;
+    uint64_t attempted, sent, eagain, delivered;
+    double delivered_rate;
+    uint64_t coalesced, lost, seq_gaps, reordered, no_payload;
+    uint64_t p50, p99, max;
+    double efficiency;
+};
+
+static struct storm_sender *senders;
+static struct storm_receiver *rx;
+static sigset_t storm_mask;
+
+/* Receiver process: account for every signal until SIGUSR2 */
+static void receiver_main(void)
+{
+    static struct rt_stream streams[MAX_SENDERS][KINDS];
+    int sfd = signalfd(-1, &storm_mask, SFD_CLOEXEC);
+    if (sfd == -1) {
+        perror("signalfd");
+        _exit(1);
+    }
+
+    struct signalfd_siginfo batch[SIGFD_BATCH];
+    for (;;) {
+        ssize_t got = read(sfd, batch, sizeof(batch));
+        if (got == -1) {
+            if (errno == EINTR)
+                continue;
+            perror("read");
+            _exit(1);
+        }
+        uint64_t now = mono_ns();
+        for (size_t i = 0; i < (size_t)got / sizeof(batch[0]); i++) {
+            if (batch[i].ssi_signo == (uint32_t)SIGUSR2)
+                _exit(0);
+            enum kind k = batch[i].ssi_signo == (uint32_t)SIGUSR1 ? USR1 : RT;
+            atomic_fetch_add_explicit(&rx->delivered[k], 1, memory_order_relaxed);
+
+            struct payload p;
+            if (payload_decode(batch[i].ssi_ptr, &p) == -1) {
+                atomic_fetch_add_explicit(&rx->no_payload[k], 1, memory_order_relaxed);
+                continue;
+            }
+            struct rt_stream *s = &streams[p.channel][k];
+            uint64_t before = s->reordered;
+            uint32_t skipped = rt_stream_accept(s, p.seq);
+            if (skipped != 0)
+                atomic_fetch_add_explicit(&rx->missing[k], skipped, memory_order_relaxed);
+            if (s->reordered != before)
+                atomic_fetch_add_explicit(&rx->reordered[k], 1, memory_order_relaxed);
+            hist_record(&rx->latency, payload_age_ns(&p, now));
+        }
+        atomic_store_explicit(&rx->last_ns, now, memory_order_relaxed);
+    }
+}
+
+/* Sender process @p idx: @p rate msg/s for @p secs seconds, then exit */
+static void sender_main(int idx, pid_t receiver, double rate, double secs, int usr1_pct)
+{
+    struct storm_sender *s = &senders[idx];
+    int rt_signo = rt_channel_signo(idx % rt_channel_count());
+    uint64_t period = (uint64_t)(1e9 / rate);
+    uint64_t total = (uint64_t)(rate * secs);
+
+    /* The default 50 us timer slack would cap every sender near 20k msg/s */
+    prctl(PR_SET_TIMERSLACK, 1UL, 0UL, 0UL, 0UL);
+
+    uint64_t start = mono_ns();
+    for (uint64_t i = 0; i < total; i++) {
+        /* Open loop: a sender that fell behind sends at once to catch up */
+        uint64_t due = start + i * period;
+        if (mono_ns() < due) {
+            struct timespec ts = { (time_t)(due / 1000000000ull), (long)(due % 1000000000ull) };
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+                ;
+        }
+
+        enum kind k = (int)(i % 100) < usr1_pct ? USR1 : RT;
+        union sigval v = payload_encode(PAYLOAD_OP_DATA, (unsigned)idx, s->seq[k]);
+        s->attempted[k]++;
+        if (sigqueue(receiver, k == USR1 ? SIGUSR1 : rt_signo, v) == 0) {
+            s->sent[k]++;
+            s->seq[k]++;    /* only accepted messages take a number */
+        } else if (errno == EAGAIN) {
+            s->eagain[k]++;
+        } else {
+            _exit(1);
+        }
+    }
+    _exit(0);
+}
+
+/* Totals over every sender and the receiver, for per-step deltas */
+struct totals
+{
+    uint64_t attempted, sent[KINDS], eagain, delivered[KINDS], missing, reordered, no_payload;
+};
+
+static void snapshot(int nsenders, struct totals *t)
+{
+    memset(t, 0, sizeof(*t));
+    for (int i = 0; i < nsenders; i++) {
+        for (int k = 0; k < KINDS; k++) {
+            t->attempted += senders[i].attempted[k];
+            t->sent[k] += senders[i].sent[k];
+            t->eagain += senders[i].eagain[k];
+        }
+    }
+    for (int k = 0; k < KINDS; k++) {
+        t->delivered[k] = atomic_load(&rx->delivered[k]);
+        t->missing += atomic_load(&rx->missing[k]);
+        t->reordered += atomic_load(&rx->reordered[k]);
+        t->no_payload += atomic_load(&rx->no_payload[k]);
+    }
+}
+
+/* Wait until the receiver has been quiet for DRAIN_QUIET_NS */
+static void drain(void)
+{
+    uint64_t start = mono_ns();
+    uint64_t seen = 0, since = start;
+    while (mono_ns() - start < DRAIN_MAX_NS) {
+        uint64_t n = atomic_load(&rx->delivered[USR1]) + atomic_load(&rx->delivered[RT]);
+        uint64_t now = mono_ns();
+        if (n != seen) {
+            seen = n;
+            since = now;
+        } else if (now - since >= DRAIN_QUIET_NS) {
+            return;
+        }
+        struct timespec pause = { 0, 1000000 };
+        nanosleep(&pause, NULL);
+    }
+}
+
+static int run_step(int nsenders, pid_t receiver, double rate, double secs, int usr1_pct,
+                    struct step_result *r)
+{
+    struct totals a, b;
+    snapshot(nsenders, &a);
+    hist_init(&rx->latency);
+
+    uint64_t start = mono_ns();
+    pid_t pids[MAX_SENDERS];
+    int forked = 0;
+    for (int i = 0; i < nsenders; i++) {
+        pids[i] = fork();
+        if (pids[i] == -1) {
+            perror("fork");
+            break;
+        }
+        if (pids[i] == 0)
+            sender_main(i, receiver, rate / nsenders, secs, usr1_pct);
+        forked++;
+    }
+    int failed = forked < nsenders;
+    for (int i = 0; i < forked; i++) {
+        int status;
+        if (waitpid(pids[i], &status, 0) == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+            failed = 1;
+    }
+    drain();
+    snapshot(nsenders, &b);
+
+    uint64_t last = atomic_load(&rx->last_ns);
+    double span = (last > start ? last - start : 1) / 1e9;
+    if (span < secs)
+        span = secs;
+
+    uint64_t delivered_usr1 = b.delivered[USR1] - a.delivered[USR1];
+    uint64_t delivered_rt = b.delivered[RT] - a.delivered[RT];
+    uint64_t sent_usr1 = b.sent[USR1] - a.sent[USR1];
+    uint64_t sent_rt = b.sent[RT] - a.sent[RT];
+
+    r->offered = rate;
+    r->attempted = b.attempted - a.attempted;
+    r->sent = sent_usr1 + sent_rt;
+    r->eagain = b.eagain - a.eagain;
+    r->delivered = delivered_usr1 + delivered_rt;
+    r->delivered_rate = r->delivered / span;
+    r->coalesced = sent_usr1 > delivered_usr1 ? sent_usr1 - delivered_usr1 : 0;
+    r->lost = sent_rt > delivered_rt ? sent_rt - delivered_rt : 0;
+    r->seq_gaps = b.missing - a.missing;
+    r->reordered = b.reordered - a.reordered;
+    r->no_payload = b.no_payload - a.no_payload;
+    r->p50 = hist_percentile(&rx->latency, 50.0);
+    r->p99 = hist_percentile(&rx->latency, 99.0);
+    r->max = rx->latency.count ? rx->latency.max : 0;
+    r->efficiency = r->delivered_rate / rate;
+    return failed ? -1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    int nsenders = DEFAULT_SENDERS;
+    double start_rate = DEFAULT_START, max_rate = DEFAULT_MAX;
+    double growth = DEFAULT_GROWTH, secs = DEFAULT_STEP_SECS;
+    int usr1_pct = DEFAULT_USR1_PCT;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "m:r:R:g:d:u:")) != -1) {
+        switch (opt) {
+        case 'm':
+            nsenders = atoi(optarg);
+            break;
+        case 'r':
+            start_rate = atof(optarg);
+            break;
+        case 'R':
+            max_rate = atof(optarg);
+            break;
+        case 'g':
+            growth = atof(optarg);
+            break;
+        case 'd':
+            secs = atof(optarg);
+            break;
+        case 'u':
+            usr1_pct = atoi(optarg);
+            break;
+        default:
+            goto usage;
+        }
+    }
+    if (nsenders < 1 || nsenders > MAX_SENDERS || start_rate <= 0 || max_rate < start_rate ||
+        growth <= 1.0 || secs <= 0 || usr1_pct < 0 || usr1_pct > 100)
+        goto usage;
+
+    senders = mmap(NULL, sizeof(*senders) * MAX_SENDERS, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    rx = mmap(NULL, sizeof(*rx), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (senders == MAP_FAILED || rx == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+
+    /* Blocked before the receiver exists, so nothing can arrive unhandled */
+    sigemptyset(&storm_mask);
+    sigaddset(&storm_mask, SIGUSR1);
+    sigaddset(&storm_mask, SIGUSR2);
+    for (int i = 0; i < nsenders && i < rt_channel_count(); i++)
+        sigaddset(&storm_mask, rt_channel_signo(i));
+    sigprocmask(SIG_BLOCK, &storm_mask, NULL);
+
+    pid_t receiver = fork();
+    if (receiver == -1) {
+        perror("fork");
+        return 1;
+    }
+    if (receiver == 0)
+        receiver_main();
+
+    fprintf(stderr, "[STORM] %d sender(s) -> PID %d, %d%% SIGUSR1, %.1f s per step, rate %.0f..%.0f x%.2f\n",
+            nsenders, receiver, usr1_pct, secs, start_rate, max_rate, growth);
+    rt_print_headroom(stderr);
+
+    static struct step_result steps[MAX_STEPS];
+    int nsteps = 0, knee = -1, past = 0, failed = 0;
+    for (double rate = start_rate; rate <= max_rate * 1.0001 && nsteps < MAX_STEPS; rate *= growth) {
+        struct step_result *r = &steps[nsteps++];
+        if (run_step(nsenders, receiver, rate, secs, usr1_pct, r) == -1)
+            failed = 1;
+        fprintf(stderr, "[STORM] offered %9.0f/s delivered %9.0f/s (%5.1f%%)  eagain %llu coalesced %llu "
+                "lost %llu gaps %llu reordered %llu  p99 %.1f us\n",
+                r->offered, r->delivered_rate, 100.0 * r->efficiency, (unsigned long long)r->eagain,
+                (unsigned long long)r->coalesced, (unsigned long long)r->lost,
+                (unsigned long long)r->seq_gaps, (unsigned long long)r->reordered, r->p99 / 1e3);
+
+        if (r->efficiency >= KNEE_EFFICIENCY) {
+            if (past == 0)
+                knee = nsteps - 1;
+        } else if (++past >= STEPS_PAST_KNEE) {
+            break;
+        }
+    }
+
+    kill(receiver, SIGUSR2);
+    waitpid(receiver, NULL, 0);
+
+    printf("step,senders,usr1_pct,offered_per_s,attempted,sent,eagain,delivered,delivered_per_s,"
+           "coalesced,lost,seq_gaps,reordered,no_payload,latency_p50_ns,latency_p99_ns,latency_max_ns,"
+           "efficiency,knee\n");
+    for (int i = 0; i < nsteps; i++) {
+        const struct step_result *r = &steps[i];
+        printf("%d,%d,%d,%.0f,%llu,%llu,%llu,%llu,%.0f,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%.4f,%d\n",
+               i, nsenders, usr1_pct, r->offered, (unsigned long long)r->attempted,
+               (unsigned long long)r->sent, (unsigned long long)r->eagain,
+               (unsigned long long)r->delivered, r->delivered_rate, (unsigned long long)r->coalesced,
+               (unsigned long long)r->lost, (unsigned long long)r->seq_gaps,
+               (unsigned long long)r->reordered,
+               (unsigned long long)r->no_payload, (unsigned long long)r->p50,
+               (unsigned long long)r->p99, (unsigned long long)r->max, r->efficiency, i == knee);
+    }
+
+    if (knee >= 0)
+        fprintf(stderr, "[STORM] knee: %.0f msg/s offered, %.0f msg/s delivered\n",
+                steps[knee].offered, steps[knee].delivered_rate);
+    else
+        fprintf(stderr, "[STORM] no knee: even %.0f msg/s was not kept up with\n", start_rate);
+    return failed;
+
+usage:
+    fprintf(stderr, "Usage: %s [-m senders(1-%d)] [-r start_rate] [-R max_rate] [-g growth(>1)] "
+                    "[-d step_seconds] [-u usr1_percent]\n", argv[0], MAX_SENDERS);
+    return 1;
+}
@@ -0,0 +1,172 @@
+/**
+ * @file        : sig_trace.c
+ * @brief       : mmap'd binary signal trace writer and reader.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "sig_trace.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+_Static_assert(sizeof(struct sig_trace_rec) == 32, "trace record layout");
+_Static_assert(sizeof(struct sig_trace_hdr) == 64, "trace header layout");
+
+int st_create(struct sig_trace *t, const char *path, uint64_t capacity)
+{
+    memset(t, 0, sizeof(*t));
+    t->fd = -1;
+    if (capacity == 0)
+        capacity = SIG_TRACE_DEFAULT_RECORDS;
+
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd == -1) {
+        perror(path);
+        return -1;
+    }
+
+    /* Sparse: only pages that receive records ever use disk */
+    size_t len = sizeof(struct sig_trace_hdr) + capacity * sizeof(struct sig_trace_rec);
+    if (ftruncate(fd, (off_t)len) == -1) {
+        perror("ftruncate");
+        close(fd);
+        return -1;
+    }
+
+    void *map = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        perror("mmap");
+        close(fd);
+        return -1;
+    }
+
+    struct sig_trace_hdr *hdr = map;
+    hdr->version = SIG_TRACE_VERSION;
+    hdr->rec_size = sizeof(struct sig_trace_rec);
+    hdr->capacity = capacity;
+    hdr->recorder_pid = getpid();
+    atomic_store(&hdr->next, 0);
+    atomic_store(&hdr->dropped, 0);
+    hdr->magic = SIG_TRACE_MAGIC;
+
+    t->hdr = hdr;
+    t->recs = (struct sig_trace_rec *)(hdr + 1);
+    t->map_len = len;
+    t->fd = fd;
+    return 0;
+}
+
+int st_open(struct sig_trace *t, const char *path)
+{
+    memset(t, 0, sizeof(*t));
+    t->fd = -1;
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        perror(path);
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == -1 || (size_t)st.st_size < sizeof(struct sig_trace_hdr)) {
+        fprintf(stderr, "%s: not a signal trace\n", path);
+        close(fd);
+        return -1;
+    }
+
+    void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        perror("mmap");
+        return -1;
+    }
+
+    struct sig_trace_hdr *hdr = map;
+    if (hdr->magic != SIG_TRACE_MAGIC || hdr->version != SIG_TRACE_VERSION ||
+        hdr->rec_size != sizeof(struct sig_trace_rec)) {
+        fprintf(stderr, "%s: not a signal trace (or a different version)\n", path);
+        munmap(map, (size_t)st.st_size);
+        return -1;
+    }
+
+    t->hdr = hdr;
+    t->recs = (struct sig_trace_rec *)(hdr + 1);
+    t->map_len = (size_t)st.st_size;
+    return 0;
+}
+
+void st_append(struct sig_trace *t, int signo, pid_t pid, int code, uint64_t value)
+{
+    struct sig_trace_hdr *hdr = t->hdr;
+    if (hdr == NULL)
+        return;
+
+    uint64_t idx = atomic_fetch_add_explicit(&hdr->next, 1, memory_order_relaxed);
+    if (idx >= hdr->capacity) {
+        atomic_fetch_add_explicit(&hdr->dropped, 1, memory_order_relaxed);
+        return;
+    }
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    struct sig_trace_rec *r = &t->recs[idx];
+    r->ts_ns = (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+    r->pid = pid;
+    r->code = code;
+    r->value = value;
+    /* Publish: a non-zero signo means the rest of the record is valid */
+    atomic_thread_fence(memory_order_release);
+    r->signo = signo;
+}
+
+void st_record(struct sig_trace *t, int signo, const siginfo_t *info)
+{
+    if (info != NULL)
+        st_append(t, signo, info->si_pid, info->si_code,
+                  (uint64_t)(uintptr_t)info->si_value.sival_ptr);
+    else
+        st_append(t, signo, 0, 0, 0);
+}
+
+uint64_t st_count(const struct sig_trace *t)
+{
+    uint64_t n = atomic_load_explicit(&t->hdr->next, memory_order_acquire);
+    return n < t->hdr->capacity ? n : t->hdr->capacity;
+}
+
+uint64_t st_dropped(const struct sig_trace *t)
+{
+    return atomic_load_explicit(&t->hdr->dropped, memory_order_relaxed);
+}
+
+void st_close(struct sig_trace *t)
+{
+    if (t->hdr == NULL)
+        return;
+
+    if (t->fd >= 0) {
+        /* Give back the unused tail; the header keeps the real capacity */
+        size_t used = sizeof(struct sig_trace_hdr) + st_count(t) * sizeof(struct sig_trace_rec);
+        t->hdr->capacity = st_count(t);
+        munmap(t->hdr, t->map_len);
+        if (ftruncate(t->fd, (off_t)used) == -1)
+            perror("ftruncate");
+        close(t->fd);
+    } else {
+        munmap(t->hdr, t->map_len);
+    }
+    memset(t, 0, sizeof(*t));
+    t->fd = -1;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file        : sig_trace.h
+ * @brief       : Binary signal trace: fixed-size records appended to an mmap'd file.
+ *
+ * Details      :
+ * - The trace file is a header followed by a preallocated (sparse) array of
+ *   32-byte records: CLOCK_MONOTONIC timestamp, signo, si_pid, si_code and
+ *   the full 64-bit si_value.
+ * - Appending is one atomic fetch-add on the index in the mapped header plus
+ *   plain stores into the mapping: no syscall per event, no locks, so
+ *   st_record() is async-signal-safe and safe from several threads.
+ * - signo is stored last (after a release fence), so a reader treats a
+ *   record whose signo is still 0 as unfinished, e.g. after a crash.
+ * - When the file is full further events are only counted as dropped.
+ * - st_close() trims the file to the records actually written.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#ifndef SIG_TRACE_H
+#define SIG_TRACE_H
+
+#include <signal.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#define SIG_TRACE_MAGIC   0x45434152544753ULL  /* "SGTRACE" */
+#define SIG_TRACE_VERSION 1
+
+/* Records preallocated when the caller does not say (32 MiB, sparse) */
+#define SIG_TRACE_DEFAULT_RECORDS (1u << 20)
+
+/** One recorded signal */
+struct sig_trace_rec
+{
+    uint64_t ts_ns;     /* CLOCK_MONOTONIC when it was received */
+    int32_t signo;      /* 0 while the record is being written */
+    int32_t pid;        /* si_pid */
+    int32_t code;       /* si_code */
+    uint32_t reserved;
+    uint64_t value;     /* si_value (sival_ptr, so sival_int is the low half) */
+};
+
+/** File header, one cache line */
+struct sig_trace_hdr
+{
+    uint64_t magic;
+    uint32_t version;
+    uint32_t rec_size;
+    uint64_t capacity;          /* records the file has room for */
+    _Atomic uint64_t next;      /* next record to fill */
+    _Atomic uint64_t dropped;   /* events that found the file full */
+    int32_t recorder_pid;
+    uint32_t reserved;
+    uint64_t pad[2];
+};
+
+/** An open trace (writer or reader) */
+struct sig_trace
+{
+    struct sig_trace_hdr *hdr;
+    struct sig_trace_rec *recs;
+    size_t map_len;
+    int fd;
+};
+
+/**
+ * @brief Create (or replace) @p path with room for @p capacity records.
+ * @return 0 on success, -1 on failure (message printed).
+ */
+int st_create(struct sig_trace *t, const char *path, uint64_t capacity);
+
+/**
+ * @brief Map an existing trace read-only.
+ * @return 0 on success, -1 on failure (message printed).
+ */
+int st_open(struct sig_trace *t, const char *path);
+
+/**
+ * @brief Append one signal as seen by an SA_SIGINFO handler (@p info may be NULL).
+ *        Async-signal-safe; does nothing if @p t was never created.
+ */
+void st_record(struct sig_trace *t, int signo, const siginfo_t *info);
+
+/** @brief Append one signal from explicit fields (signalfd, sigwaitinfo paths). */
+void st_append(struct sig_trace *t, int signo, pid_t pid, int code, uint64_t value);
+
+/** @brief Number of records in the trace (written or reserved). */
+uint64_t st_count(const struct sig_trace *t);
+
+/** @brief Events lost because the trace was full. */
+uint64_t st_dropped(const struct sig_trace *t);
+
+/** @brief Unmap; a writer also trims the file to the records written. */
+void st_close(struct sig_trace *t);
+
+#endif /* SIG_TRACE_H */
@@ -3,9 +3,16 @@
  * @brief       : Program that schedules an alarm to send SIGALRM after 5 seconds.
  *
  * Details      :
- * - Installs a handler for SIGALRM using signal().
+ * - Installs a handler for SIGALRM using sigaction() through the signal
+ *   runtime (sigrt.h); signal() would reset to the default action after
+ *   one delivery under _POSIX_C_SOURCE.
  * - Schedules an alarm to fire after 5 seconds.
- * - Prints a message when SIGALRM is received, then continues waiting.
+ * - The signal handler only queues the event; the main loop dispatches it
+ *   to handle_alarm(), which prints a message, then continues waiting.
+ * - With -n, schedules many timers instead of one alarm(): a hierarchical
+ *   timer wheel is driven by a single periodic timer_create() timer that
+ *   delivers SIGALRM every tick (-r microseconds). The timers are spread
+ *   over the same 5 seconds and their firing jitter is reported.
  *
  * Course       : CPE 2600 – Systems Programming
  * Section      : 112
@@ -13,39 +20,149 @@
  * Modified by  : Jesse Rost <rostj@msoe.edu>
  * Date         : 11/10/25
  *
- * Compile      : gcc -Wall -Wextra signal_alarm.c -o signal_alarm
- * Usage        : ./signal_alarm
+ * Compile      : make signal_alarm
+ * Usage        : ./signal_alarm [-n timers [-r tick_us]]
+ * Example      : ./signal_alarm -n 20000 -r 100
  *
  * Algorithm
  *  - Register SIGALRM handler.
- *  - Start a 5-second alarm.
- *  - Pause in a loop waiting for signals.
+ *  - Start a 5-second alarm (or the wheel's tick timer plus N wheel timers).
+ *  - Sleep in sigsuspend() in a loop, printing queued events after each
+ *    wakeup (or advancing the wheel on every tick).
  */
 
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
+#include <stdlib.h>
 #include <signal.h>
 #include <unistd.h>
 
-/* Signal handler for SIGALRM */
-void handle_alarm(int signum) {
-    /* tells which signal arrived if needed */
-    (void)signum;
-    printf("Received SIGALRM signal! Alarm went off after 5 seconds.\n");
+#include "sigrt.h"
+#include "timer_wheel.h"
+#include "latency_hist.h"
+
+/* How far out the alarm (and the spread of wheel timers) goes */
+#define ALARM_SECONDS 5
+
+/* Handler for SIGALRM; runs from sigrt_dispatch() in the main loop, and
+   @p state is the message to print (NULL for wheel ticks) */
+void handle_alarm(const struct sig_event *ev, const struct payload *p, void *state) {
+    (void)ev;
+    (void)p;
+    if (state != NULL)
+        printf("%s\n", (const char *)state);
 }
 
-int main(void) {
+/* Wheel mode: every timer remembers when it was supposed to fire */
+struct alarm_timer {
+    struct tw_timer timer;
+    uint64_t due_ns;
+};
+
+static struct latency_hist lateness;
+static long fired = 0;
+
+/* Runs from tw_run() in the main loop, never in signal context */
+static void on_timer(struct tw_timer *timer, void *arg) {
+    (void)timer;
+    struct alarm_timer *at = arg;
+    uint64_t now = mono_ns();
+    hist_record(&lateness, now > at->due_ns ? now - at->due_ns : 0);
+    fired++;
+}
+
+/* Schedule n timers over ALARM_SECONDS on a wheel ticking every tick_us */
+static int run_wheel(long n, long tick_us, const sigset_t *waitmask) {
+    static struct timer_wheel wheel;
+    struct alarm_timer *timers = calloc((size_t)n, sizeof(*timers));
+    if (timers == NULL) {
+        perror("calloc");
+        return 1;
+    }
+
+    tw_init(&wheel, (uint64_t)tick_us * 1000);
+    hist_init(&lateness);
+    srand((unsigned int)getpid());
+
+    uint64_t span_ns = ALARM_SECONDS * 1000000000ull;
+    uint64_t start = mono_ns();
+    for (long i = 0; i < n; i++) {
+        uint64_t delay = 1 + (uint64_t)((double)rand() / RAND_MAX * span_ns);
+        timers[i].due_ns = start + delay;
+        tw_timer_init(&timers[i].timer, on_timer, &timers[i]);
+        /* Ticks are counted from tw_init(); convert the absolute due time */
+        tw_add(&wheel, &timers[i].timer,
+               (timers[i].due_ns - wheel.origin_ns + wheel.tick_ns - 1) / wheel.tick_ns);
+    }
+    uint64_t setup = mono_ns() - start;
+
+    if (tw_start_clock(&wheel, SIGALRM) == -1) {
+        free(timers);
+        return 1;
+    }
+
+    printf("%ld timers set over %d seconds on a %ld us wheel (%.1f ns per insert). Waiting...\n",
+           n, ALARM_SECONDS, tick_us, (double)setup / n);
+    fflush(stdout);
+
+    while (fired < n) {
+        sigsuspend(waitmask); /* Wait for the next tick */
+        sigrt_dispatch();     /* ticks carry no data; the wheel reads the clock itself */
+        tw_run(&wheel);
+    }
+    tw_stop_clock(&wheel);
+
+    printf("All %ld timers went off within %d seconds.\n", fired, ALARM_SECONDS);
+    hist_print(&lateness, "Firing lateness", stdout);
+    free(timers);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    sigset_t waitmask;
+    long ntimers = 0;
+    long tick_us = 100;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:r:")) != -1) {
+        switch (opt) {
+        case 'n':
+            ntimers = atol(optarg);
+            break;
+        case 'r':
+            tick_us = atol(optarg);
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-n timers [-r tick_us]]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    sigrt_init("signal_alarm");
+
     /* Register the handler for SIGALRM
-       tells the OS to run handle_alarm() whenever SIGALRM is sent. */
-    signal(SIGALRM, handle_alarm);
+       tells the runtime to run handle_alarm() whenever SIGALRM is sent. */
+    sigrt_on(SIGALRM, SIGRT_ANY_OP, handle_alarm,
+             ntimers > 0 ? NULL : "Received SIGALRM signal! Alarm went off after 5 seconds.");
+
+    /* SIGALRM is only delivered while we sleep in sigsuspend() */
+    if (sigrt_start(&waitmask) == -1)
+        return 1;
+
+    if (ntimers > 0)
+        return run_wheel(ntimers, tick_us > 0 ? tick_us : 1, &waitmask);
 
     /* Schedule the alarm for 5 seconds */
-    alarm(5);
+    alarm(ALARM_SECONDS);
 
     printf("Alarm set for 5 seconds. Waiting...\n");
+    fflush(stdout);
 
     /* Keep the program alive long enough for the alarm to trigger */
     while (1) {
-        pause(); /* Wait for a signal */
+        sigsuspend(&waitmask); /* Wait for a signal */
+        sigrt_dispatch();
+        fflush(stdout);
     }
 
     return 0;
@@ -3,9 +3,14 @@
  * @brief       : Sets a signal handler for SIGINT; handler prints a message and continues.
  *
  * Details      :
- * - Installs a SIGINT handler using signal().
- * - The handler prints a message but does not exit.
+ * - Registers a SIGINT handler with the signal runtime (sigrt.h), which
+ *   installs it with sigaction().
+ * - The runtime's handler queues the event but does not exit; the main loop
+ *   dispatches every queued SIGINT to handle_signal(), which prints it.
  * - The program loops and sleeps, demonstrating continued execution.
+ * - Signal counts and handler times are exported in a shared metrics page
+ *   (sig_metrics.h); every SIGINT also snapshots that page, so
+ *   ./metrics_dump -S <pid> shows the state as of the last Ctrl+C.
  *
  * Course       : CPE 2600 – Systems Programming
  * Section      : 112
@@ -13,35 +18,49 @@
  * Modified by  : Jesse Rost <rostj@msoe.edu>
  * Date         : 11/10/25
  *
- * Compile      : gcc -Wall -Wextra signal_handler.c -o signal_handler
+ * Compile      : make signal_handler
  * Usage        : ./signal_handler
  *
  * Algorithm
  *  - Register SIGINT handler.
- *  - Loop forever printing and sleeping.
+ *  - Loop forever sleeping, then printing any queued signals.
  */
 
+#define _POSIX_C_SOURCE 200809L
 #include <signal.h>
 #include <unistd.h>
 #include <stdlib.h>
 #include <stdio.h>
 
+#include "sigrt.h"
+#include "sig_metrics.h"
+
 /**
- * @brief Signal handler for SIGINT - prints a message but does not exit.
+ * @brief Handler for SIGINT - runs from the main loop, so it may print; does not exit.
  */
-void handle_signal(int signum) {
-    (void)signum;
+void handle_signal(const struct sig_event *ev, const struct payload *p, void *state) {
+    (void)ev;
+    (void)p;
+    (void)state;
     printf("Received a signal (SIGINT)\n");
+    sm_snapshot(); /* SIGINT doubles as the "take a snapshot" signal, this one included */
 }
 
 int main(void) {
-    /* Register the signal handler for SIGINT (Ctrl+C) */
-    signal(SIGINT, handle_signal);
+    sigrt_init("signal_handler");
+
+    /* Register the signal handler for SIGINT (Ctrl+C); sigaction() keeps it
+       installed across deliveries, unlike signal() under _POSIX_C_SOURCE */
+    sigrt_on(SIGINT, SIGRT_ANY_OP, handle_signal, NULL);
+    if (sigrt_start(NULL) == -1)
+        return 1;
 
     /* Loop indefinitely */
     while (1) {
         printf("Sleeping...\n");
-        sleep(1);
+        fflush(stdout);
+        sleep(1); /* cut short when a signal arrives */
+        sigrt_dispatch();
     }
 
     return 0;
@@ -1,12 +1,18 @@
 /**
  * @file        : signal_segfault.c
- * @brief       : Program that intentionally causes a segmentation fault (SIGSEGV)
- *                and installs a signal handler to catch it.
+ * @brief       : Program that uses SIGSEGV for demand paging of a huge sparse array,
+ *                and still catches a real segmentation fault.
  *
  * Details      :
- * - Installs a handler for SIGSEGV using signal().
- * - The handler prints a message when a segmentation fault occurs.
- * - The handler returns without exiting, demonstrating resuming behavior.
+ * - Reserves a 64 GiB PROT_NONE region through lazy_mem. Every first touch
+ *   of a page raises SIGSEGV; the SA_SIGINFO handler (on a sigaltstack)
+ *   reads si_addr, makes just that page read/write and returns, so the
+ *   access is re-executed and the program makes progress.
+ * - Writes and re-reads values at random indexes of the 8-billion-element
+ *   array, then reports faults taken and resident memory actually used.
+ * - Finally dereferences NULL. That fault is outside the lazy region, so it
+ *   is chained to handle_sigsegv(), which queues it in the lock-free event
+ *   queue and jumps back to a recovery point in main() to report it.
  *
  * Course       : CPE 2600 – Systems Programming
  * Section      : 112
@@ -14,36 +20,129 @@
  * Modified by  : Jesse Rost <rostj@msoe.edu>
  * Date         : 11/10/25
  *
- * Compile      : gcc -Wall -Wextra signal_segfault.c -o signal_segfault
- * Usage        : ./signal_segfault
+ * Compile      : make signal_segfault
+ * Usage        : ./signal_segfault [-t touches]
  *
  * Algorithm
- *  - Register SIGSEGV handler.
- *  - Dereference a NULL pointer to trigger SIGSEGV.
- *  - Observe handler print and program behavior.
+ *  - Register the NULL-pointer SIGSEGV handler, then reserve the lazy region
+ *    (whose handler chains to it).
+ *  - Touch random elements, verify them, print faults and RSS.
+ *  - Save a recovery point with sigsetjmp() and dereference NULL.
+ *  - Handler queues the event and siglongjmp()s back; main prints it.
  */
 
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
 #include <signal.h>
+#include <setjmp.h>
+#include <unistd.h>
 
-/* Handler for segmentation fault */
-void handle_sigsegv(int signum) {
-    (void)signum;
-    printf("Caught SIGSEGV: segmentation fault detected!\n");
+#include "event_queue.h"
+#include "lazy_mem.h"
+#include "sigrt.h"
+#include "sig_metrics.h"
+#include "latency_hist.h"
+
+/* 64 GiB of virtual address space, 8 Gi int64_t elements */
+#define ARRAY_BYTES (64ull << 30)
+#define DEFAULT_TOUCHES 10000
+
+/* Handler -> main loop queue; printing happens outside signal context */
+static struct event_queue events;
+
+/* Where the handler resumes execution after a fault */
+static sigjmp_buf recover;
+
+/* Handler for segmentation faults that are not demand-paging faults */
+void handle_sigsegv(int signum, siginfo_t *info, void *context) {
+    (void)context;
+    uint64_t start = mono_ns();
+    if (eq_push(&events, signum, info) == -1)
+        sm_dropped(signum);
+    sm_handled(signum, start);
+    siglongjmp(recover, 1);
+}
+
+/* Resident set size in KiB from /proc/self/statm */
+static long rss_kib(void) {
+    long pages = 0, resident = 0;
+    FILE *fp = fopen("/proc/self/statm", "r");
+    if (fp == NULL)
+        return -1;
+    if (fscanf(fp, "%ld %ld", &pages, &resident) != 2)
+        resident = -1;
+    fclose(fp);
+    return resident < 0 ? -1 : resident * (sysconf(_SC_PAGESIZE) / 1024);
 }
 
 int main(int argc, char *argv[]) {
-    (void)argc;
-    (void)argv;
+    long touches = DEFAULT_TOUCHES;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "t:")) != -1) {
+        if (opt == 't') {
+            touches = atol(optarg);
+        } else {
+            fprintf(stderr, "Usage: %s [-t touches]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    eq_init(&events);
+    sigrt_init("signal_segfault");
+
+    /* Install the handler for SIGSEGV; lazy_mem chains to it. It has to
+       siglongjmp() out of signal context, so it is not a dispatched one */
+    if (sigrt_action(SIGSEGV, handle_sigsegv, NULL) == -1)
+        return 1;
+
+    struct lazy_region region;
+    long rss_before = rss_kib();
+    if (lazy_reserve(&region, ARRAY_BYTES, 0) == -1)
+        return 1;
+
+    int64_t *array = (int64_t *)region.base;
+    uint64_t elements = ARRAY_BYTES / sizeof(int64_t);
+    printf("Reserved %llu GiB (%llu elements) at %p\n",
+           (unsigned long long)(ARRAY_BYTES >> 30), (unsigned long long)elements, (void *)array);
+
+    /* Write sparse random elements; each new page faults in on demand */
+    srand(42);
+    for (long i = 0; i < touches; i++) {
+        uint64_t idx = (((uint64_t)rand() << 31) ^ (uint64_t)rand()) % elements;
+        array[idx] = (int64_t)idx;
+    }
+
+    /* Re-read the same elements; the pages are already populated */
+    srand(42);
+    long bad = 0;
+    for (long i = 0; i < touches; i++) {
+        uint64_t idx = (((uint64_t)rand() << 31) ^ (uint64_t)rand()) % elements;
+        if (array[idx] != (int64_t)idx)
+            bad++;
+    }
+
+    printf("Touched %ld elements: %zu page faults handled, %ld mismatches\n",
+           touches, lazy_faults(&region), bad);
+    printf("Resident memory grew by %ld KiB for a %llu GiB array\n",
+           rss_kib() - rss_before, (unsigned long long)(ARRAY_BYTES >> 30));
+    lazy_release(&region);
 
-    /* Install the handler for SIGSEGV */
-    signal(SIGSEGV, handle_sigsegv);
+    if (sigsetjmp(recover, 1) == 0) {
+        /* Declare a null pointer */
+        volatile int *i = NULL;
 
-    /* Declare a null pointer */
-    int *i = NULL;
+        /* Dereference the null pointer */
+        printf("The value of i is: %d\n", *i);
+    }
 
-    /* Dereference the null pointer */
-    printf("The value of i is: %d\n", *i);
+    /* Back from the handler: report what it recorded */
+    struct sig_event ev;
+    while (eq_pop(&events, &ev)) {
+        printf("Caught SIGSEGV: segmentation fault detected at address %p!\n", ev.addr);
+    }
 
     /* Return to exit the program */
     return 0;
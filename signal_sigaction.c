@@ -3,9 +3,14 @@
  * @brief       : Installs a SIGUSR1 handler using sigaction and prints sender's PID.
  *
  * Details      :
- * - Uses SA_SIGINFO to access extended info (siginfo_t).
- * - Prints the sender PID when SIGUSR1 is received.
+ * - Uses SA_SIGINFO to access extended info (siginfo_t); the signal runtime
+ *   (sigrt.h) does the sigaction() call.
+ * - The signal handler only queues the siginfo in a lock-free event queue;
+ *   the main loop dispatches every queued SIGUSR1 to handle_sigusr1(),
+ *   which prints the sender PID.
  * - Waits indefinitely for incoming signals.
+ * - Optional trace (-t file): the handler also appends each signal as a
+ *   binary record to an mmap'd file (no syscall per signal) for sig_replay.
  *
  * Course       : CPE 2600 – Systems Programming
  * Section      : 112
@@ -13,13 +18,13 @@
  * Modified by  : Jesse Rost <rostj@msoe.edu>
  * Date         : 11/10/25
  *
- * Compile      : gcc -Wall -Wextra signal_sigaction.c -o signal_sigaction
- * Usage        : ./signal_sigaction
+ * Compile      : make signal_sigaction
+ * Usage        : ./signal_sigaction [-t trace_file]
  *
  * Algorithm
- *  - Configure struct sigaction with SA_SIGINFO.
- *  - Register handler for SIGUSR1.
- *  - Pause forever printing sender PID upon receipt.
+ *  - Register handler for SIGUSR1; the runtime configures struct sigaction
+ *    with SA_SIGINFO.
+ *  - Sleep in sigsuspend() forever, printing sender PIDs after each wakeup.
  *
  * To send SIGUSR1 to this process from another terminal:
  *      kill -USR1 <pid>
@@ -30,41 +35,59 @@
 #define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <signal.h>
-#include <string.h>
 #include <unistd.h>
 
-/* Correct signature for SA_SIGINFO handler */
-void handle_sigusr1(int signum, siginfo_t *info, void *context) {
-    (void)signum;
-    (void)context; /* suppress unused variable warning */
-    printf("Received SIGUSR1 from process with PID: %d\n", info->si_pid);
+#include "sigrt.h"
+#include "sig_trace.h"
+
+/* Binary trace of every SIGUSR1 (-t); recording is a no-op without it */
+static struct sig_trace trace;
+
+/* Handler for SIGUSR1; runs from sigrt_dispatch() with the queued siginfo */
+void handle_sigusr1(const struct sig_event *ev, const struct payload *p, void *state) {
+    (void)p;     /* suppress unused variable warnings */
+    (void)state;
+    printf("Received SIGUSR1 from process with PID: %d\n", ev->pid);
 }
 
-int main(void) {
-    struct sigaction sa;
+int main(int argc, char *argv[]) {
+    sigset_t waitmask;
+    int opt;
 
-    /* Zero out the sigaction struct */
-    memset(&sa, 0, sizeof(sa));
+    while ((opt = getopt(argc, argv, "t:")) != -1) {
+        if (opt != 't') {
+            fprintf(stderr, "Usage: %s [-t trace_file]\n", argv[0]);
+            return 1;
+        }
+        /* Records live in a shared file mapping, so the trace stays
+           complete when Ctrl+C kills us (the file is just not trimmed) */
+        if (st_create(&trace, optarg, 0) == -1)
+            return 1;
+    }
 
-    /* Assign the handler function */
-    sa.sa_sigaction = handle_sigusr1;
+    /* Event queue, metrics page, and the trace if -t created one */
+    sigrt_init("signal_sigaction");
+    sigrt_trace(&trace);
 
-    /* Tell sigaction to use sa_sigaction instead of sa_handler */
-    sa.sa_flags = SA_SIGINFO;
+    /* Register the handler for SIGUSR1, whatever payload it carries */
+    sigrt_on(SIGUSR1, SIGRT_ANY_OP, handle_sigusr1, NULL);
 
-    /* Register the handler for SIGUSR1 */
-    if (sigaction(SIGUSR1, &sa, NULL) == -1) {
-        perror("sigaction");
+    /* Install it with SA_SIGINFO; SIGUSR1 is only delivered while we
+       sleep in sigsuspend() */
+    if (sigrt_start(&waitmask) == -1)
         return 1;
-    }
 
     /* Display the process ID so you can send the signal */
     printf("Process running with PID: %d\n", getpid());
     printf("Waiting for SIGUSR1...\n");
 
+    fflush(stdout);
+
     /* Wait forever for signals */
     while (1) {
-        pause(); /* Suspend until signal arrives */
+        sigsuspend(&waitmask); /* Suspend until signal arrives */
+        sigrt_dispatch();
+        fflush(stdout);
     }
 
     return 0;
@@ -0,0 +1,488 @@
+/**
+ * @file        : sigq_monitor.c
+ * @brief       : Live monitor of signal queue depth and pending signals across processes.
+ *
+ * Details      :
+ * - Watches the given PIDs, and every process whose name matches one of the
+ *   given program names (e.g. recv_signal); new matches are picked up on
+ *   each report.
+ * - Samples SigQ, SigPnd, ShdPnd and SigBlk from /proc/<pid>/status at a
+ *   high rate. Each status file stays open and is re-read with pread() from
+ *   the remembered offset of its "SigQ:" line, so only the signal block is
+ *   copied. It is only parsed when those bytes changed since the last sample.
+ * - Keeps a per-process ring of samples and fits a line through the last
+ *   window to get the SigQ growth rate in signals/s.
+ * - SigQ counts every signal queued for the process's real UID (the number
+ *   RLIMIT_SIGPENDING limits), while SigPnd/ShdPnd show which signals are
+ *   pending for that process. A process is flagged GROWING when SigQ keeps
+ *   rising while it has signals pending, and STUCK when it has had pending
+ *   signals in every sample of the window. That is the slow receiver that
+ *   is about to make its senders hit EAGAIN.
+ * - With -o, the time series is written as CSV on exit.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ *
+ * Compile      : make sigq_monitor
+ * Usage        : ./sigq_monitor [-i interval_us] [-w window] [-g growth_per_s]
+ *                               [-d seconds] [-o series.csv] <pid|name>...
+ * Example      : ./sigq_monitor -i 1000 -o sigq.csv recv_signal 12345
+ *
+ * Algorithm
+ *  1. Open /proc/<pid>/status for every PID argument and every process whose
+ *     comm matches a name argument.
+ *  2. Every interval: pread() the signal block at the cached offset, skip
+ *     parsing if it is byte-identical to the last one, otherwise parse and
+ *     append a sample. Fall back to a full read if the offset moved.
+ *  3. Once per second: rescan /proc for new matches, fit the SigQ slope over
+ *     the window, flag growing/stuck receivers and print one line each.
+ *  4. On SIGINT or after -d seconds: print totals and write the CSV.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <ctype.h>
+#include <signal.h>
+#include <time.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <unistd.h>
+
+#include "latency_hist.h"
+
+#define MAX_WATCH      1024
+#define MAX_NAMES      32
+#define SERIES_LEN     4096     /* samples kept per process */
+#define STATUS_MAX     4096     /* whole /proc/<pid>/status */
+#define BLOCK_SLACK    64       /* bytes read before the cached SigQ offset */
+#define BLOCK_LEN      256      /* bytes read per sample: the signal lines */
+
+#define DEFAULT_INTERVAL_US 10000
+#define DEFAULT_WINDOW      100
+#define DEFAULT_GROWTH      100.0
+
+/* One parsed sample of the signal fields */
+struct sample {
+    uint64_t t_ns;
+    long sigq;
+    long sigq_limit;
+    uint64_t sigpnd;
+    uint64_t shdpnd;
+    uint64_t sigblk;
+};
+
+/* One watched process */
+struct watch {
+    pid_t pid;
+    char name[16];
+    int fd;                     /* /proc/<pid>/status, -1 once gone */
+    off_t sigq_off;             /* offset of "SigQ:" when last found */
+    char block[BLOCK_LEN];      /* signal lines as last seen */
+    size_t block_len;
+    struct sample series[SERIES_LEN];
+    uint64_t count;             /* samples appended (ring index = count % SERIES_LEN) */
+    uint64_t reads, parses, full_reads;
+    int flag_growing, flag_stuck;
+    double slope;               /* SigQ growth in signals/s over the window */
+};
+
+static struct watch *watches[MAX_WATCH];
+static int nwatch = 0;
+static const char *names[MAX_NAMES];
+static int nnames = 0;
+
+static volatile sig_atomic_t stop = 0;
+
+static void handle_stop(int signum)
+{
+    (void)signum;
+    stop = 1;
+}
+
+/* Is @p pid already watched? */
+static int watching(pid_t pid)
+{
+    for (int i = 0; i < nwatch; i++)
+        if (watches[i]->pid == pid)
+            return 1;
+    return 0;
+}
+
+/* Read /proc/<pid>/comm into @p out (empty on failure) */
+static void read_comm(pid_t pid, char out[16])
+{
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/comm", pid);
+    out[0] = '\0';
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+        return;
+    ssize_t n = read(fd, out, 15);
+    close(fd);
+    if (n <= 0)
+        return;
+    out[n] = '\0';
+    char *nl = strchr(out, '\n');
+    if (nl != NULL)
+        *nl = '\0';
+}
+
+static int add_watch(pid_t pid)
+{
+    if (nwatch == MAX_WATCH || watching(pid))
+        return -1;
+
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/status", pid);
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+        return -1;
+
+    struct watch *w = calloc(1, sizeof(*w));
+    if (w == NULL) {
+        close(fd);
+        return -1;
+    }
+    w->pid = pid;
+    w->fd = fd;
+    w->sigq_off = -1;
+    read_comm(pid, w->name);
+    watches[nwatch++] = w;
+    return 0;
+}
+
+/* Watch every process whose comm matches one of the name arguments */
+static void scan_names(void)
+{
+    if (nnames == 0)
+        return;
+    DIR *proc = opendir("/proc");
+    if (proc == NULL)
+        return;
+
+    pid_t self = getpid();
+    struct dirent *de;
+    while ((de = readdir(proc)) != NULL) {
+        if (!isdigit((unsigned char)de->d_name[0]))
+            continue;
+        pid_t pid = (pid_t)atoi(de->d_name);
+        if (pid == self || watching(pid))
+            continue;
+
+        char comm[16];
+        read_comm(pid, comm);
+        for (int i = 0; i < nnames; i++) {
+            /* comm is truncated to 15 characters by the kernel */
+            if (comm[0] != '\0' && strncmp(comm, names[i], 15) == 0) {
+                add_watch(pid);
+                break;
+            }
+        }
+    }
+    closedir(proc);
+}
+
+/* Locate the signal block ("SigQ:" .. end of "SigBlk:" line) in @p buf */
+static const char *find_block(const char *buf, size_t len, size_t *block_len)
+{
+    const char *start = NULL;
+    for (size_t i = 0; i + 5 <= len; i++) {
+        if ((i == 0 || buf[i - 1] == '\n') && memcmp(buf + i, "SigQ:", 5) == 0) {
+            start = buf + i;
+            break;
+        }
+    }
+    if (start == NULL)
+        return NULL;
+
+    /* The block ends after the SigBlk line; it must be complete in the buffer */
+    const char *end = buf + len;
+    const char *blk = NULL;
+    for (const char *p = start + 1; p + 7 <= end; p++) {
+        if (p[-1] == '\n' && memcmp(p, "SigBlk:", 7) == 0) {
+            blk = p;
+            break;
+        }
+    }
+    if (blk == NULL)
+        return NULL;
+    const char *nl = memchr(blk, '\n', (size_t)(end - blk));
+    if (nl == NULL)
+        return NULL;
+    *block_len = (size_t)(nl + 1 - start);
+    return start;
+}
+
+/* Parse the signal block into @p s; returns 0 on success */
+static int parse_block(const char *block, size_t len, struct sample *s)
+{
+    char text[BLOCK_LEN + 1];
+    memcpy(text, block, len);
+    text[len] = '\0';
+
+    int found = 0;
+    for (char *line = text; line != NULL && *line != '\0';) {
+        char *next = strchr(line, '\n');
+        if (next != NULL)
+            *next++ = '\0';
+        if (strncmp(line, "SigQ:", 5) == 0 && sscanf(line + 5, "%ld/%ld", &s->sigq, &s->sigq_limit) == 2)
+            found |= 1;
+        else if (strncmp(line, "SigPnd:", 7) == 0)
+            s->sigpnd = strtoull(line + 7, NULL, 16), found |= 2;
+        else if (strncmp(line, "ShdPnd:", 7) == 0)
+            s->shdpnd = strtoull(line + 7, NULL, 16), found |= 4;
+        else if (strncmp(line, "SigBlk:", 7) == 0)
+            s->sigblk = strtoull(line + 7, NULL, 16), found |= 8;
+        line = next;
+    }
+    return found == 15 ? 0 : -1;
+}
+
+/* Take one sample of @p w; marks it gone when the process has exited */
+static void sample_watch(struct watch *w, uint64_t now)
+{
+    char buf[STATUS_MAX];
+    const char *block = NULL;
+    size_t block_len = 0;
+
+    w->reads++;
+    if (w->sigq_off >= 0) {
+        /* Fast path: only the bytes around where SigQ was last time */
+        off_t from = w->sigq_off > BLOCK_SLACK ? w->sigq_off - BLOCK_SLACK : 0;
+        ssize_t n = pread(w->fd, buf, BLOCK_SLACK + BLOCK_LEN, from);
+        if (n > 0)
+            block = find_block(buf, (size_t)n, &block_len);
+        if (block != NULL)
+            w->sigq_off = from + (off_t)(block - buf);
+    }
+    if (block == NULL) {
+        /* First read, or earlier lines changed length: read it all again */
+        w->full_reads++;
+        ssize_t n = pread(w->fd, buf, sizeof(buf), 0);
+        if (n <= 0) {
+            close(w->fd); /* ESRCH or empty: the process is gone */
+            w->fd = -1;
+            return;
+        }
+        block = find_block(buf, (size_t)n, &block_len);
+        if (block == NULL)
+            return;
+        w->sigq_off = (off_t)(block - buf);
+    }
+    if (block_len > BLOCK_LEN)
+        block_len = BLOCK_LEN;
+
+    /* Unchanged bytes mean an unchanged sample: repeat the last one */
+    struct sample s;
+    if (w->count > 0 && block_len == w->block_len && memcmp(block, w->block, block_len) == 0) {
+        s = w->series[(w->count - 1) % SERIES_LEN];
+    } else {
+        memset(&s, 0, sizeof(s));
+        if (parse_block(block, block_len, &s) == -1)
+            return;
+        w->parses++;
+        memcpy(w->block, block, block_len);
+        w->block_len = block_len;
+    }
+    s.t_ns = now;
+    w->series[w->count % SERIES_LEN] = s;
+    w->count++;
+}
+
+/* Least-squares SigQ slope (signals/s) and stuck check over the last @p window samples */
+static void analyse(struct watch *w, unsigned window, double growth)
+{
+    uint64_t n = w->count < window ? w->count : window;
+    w->flag_growing = w->flag_stuck = 0;
+    w->slope = 0;
+    if (n < 2)
+        return;
+
+    const struct sample *first = &w->series[(w->count - n) % SERIES_LEN];
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    int always_pending = 1;
+    for (uint64_t k = w->count - n; k < w->count; k++) {
+        const struct sample *s = &w->series[k % SERIES_LEN];
+        double x = (s->t_ns - first->t_ns) / 1e9;
+        double y = (double)s->sigq;
+        sx += x;
+        sy += y;
+        sxx += x * x;
+        sxy += x * y;
+        if ((s->sigpnd | s->shdpnd) == 0)
+            always_pending = 0;
+    }
+    double denom = n * sxx - sx * sx;
+    if (denom > 0)
+        w->slope = (n * sxy - sx * sy) / denom;
+
+    const struct sample *last = &w->series[(w->count - 1) % SERIES_LEN];
+    w->flag_growing = w->slope > growth && (last->sigpnd | last->shdpnd) != 0;
+    w->flag_stuck = always_pending && n == window;
+}
+
+/* Count of pending signal numbers in a mask */
+static int popcount64(uint64_t v)
+{
+    int c = 0;
+    for (; v != 0; v &= v - 1)
+        c++;
+    return c;
+}
+
+static void report(unsigned window, double growth, double elapsed)
+{
+    printf("[%7.1fs] %-7s %-15s %13s %9s %7s %7s  %s\n", elapsed,
+           "PID", "NAME", "SIGQ", "SIGQ/S", "PEND", "BLOCKED", "STATE");
+    for (int i = 0; i < nwatch; i++) {
+        struct watch *w = watches[i];
+        if (w->count == 0)
+            continue;
+        analyse(w, window, growth);
+        const struct sample *s = &w->series[(w->count - 1) % SERIES_LEN];
+        char sigq[32];
+        snprintf(sigq, sizeof(sigq), "%ld/%ld", s->sigq, s->sigq_limit);
+        printf("           %-7d %-15s %13s %9.0f %7d %7d  %s%s%s\n", w->pid, w->name, sigq,
+               w->slope, popcount64(s->sigpnd | s->shdpnd), popcount64(s->sigblk),
+               w->fd < 0 ? "exited" : (w->flag_growing || w->flag_stuck) ? "" : "ok",
+               w->flag_growing ? "GROWING " : "", w->flag_stuck ? "STUCK" : "");
+    }
+    fflush(stdout);
+}
+
+static int write_series(const char *path)
+{
+    FILE *out = fopen(path, "w");
+    if (out == NULL) {
+        perror("fopen");
+        return -1;
+    }
+    fprintf(out, "pid,name,t_ns,sigq,sigq_limit,sigpnd,shdpnd,sigblk\n");
+    for (int i = 0; i < nwatch; i++) {
+        const struct watch *w = watches[i];
+        uint64_t from = w->count > SERIES_LEN ? w->count - SERIES_LEN : 0;
+        for (uint64_t k = from; k < w->count; k++) {
+            const struct sample *s = &w->series[k % SERIES_LEN];
+            fprintf(out, "%d,%s,%llu,%ld,%ld,%016llx,%016llx,%016llx\n", w->pid, w->name,
+                    (unsigned long long)s->t_ns, s->sigq, s->sigq_limit,
+                    (unsigned long long)s->sigpnd, (unsigned long long)s->shdpnd,
+                    (unsigned long long)s->sigblk);
+        }
+    }
+    fclose(out);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    long interval_us = DEFAULT_INTERVAL_US;
+    unsigned window = DEFAULT_WINDOW;
+    double growth = DEFAULT_GROWTH;
+    double seconds = 0;
+    const char *csv = NULL;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "i:w:g:d:o:")) != -1) {
+        switch (opt) {
+        case 'i':
+            interval_us = atol(optarg);
+            break;
+        case 'w':
+            window = (unsigned)atoi(optarg);
+            break;
+        case 'g':
+            growth = atof(optarg);
+            break;
+        case 'd':
+            seconds = atof(optarg);
+            break;
+        case 'o':
+            csv = optarg;
+            break;
+        default:
+            optind = argc; /* force the usage message below */
+            break;
+        }
+    }
+    if (optind >= argc || interval_us <= 0 || window < 2 || window > SERIES_LEN) {
+        fprintf(stderr, "Usage: %s [-i interval_us] [-w window] [-g growth_per_s] "
+                        "[-d seconds] [-o series.csv] <pid|name>...\n", argv[0]);
+        return 1;
+    }
+
+    for (int i = optind; i < argc; i++) {
+        if (isdigit((unsigned char)argv[i][0])) {
+            if (add_watch((pid_t)atoi(argv[i])) == -1)
+                fprintf(stderr, "PID %s: cannot watch\n", argv[i]);
+        } else if (nnames < MAX_NAMES) {
+            names[nnames++] = argv[i];
+        }
+    }
+    scan_names();
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = handle_stop;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    printf("Sampling %d process(es) every %ld us, window %u samples, growth threshold %.0f/s\n",
+           nwatch, interval_us, window, growth);
+    fflush(stdout);
+
+    uint64_t period = (uint64_t)interval_us * 1000u;
+    uint64_t start = mono_ns();
+    uint64_t next_report = start + 1000000000ull;
+    uint64_t samples = 0;
+    struct timespec due;
+    clock_gettime(CLOCK_MONOTONIC, &due);
+
+    while (!stop) {
+        uint64_t now = mono_ns();
+        for (int i = 0; i < nwatch; i++)
+            if (watches[i]->fd >= 0)
+                sample_watch(watches[i], now);
+        samples++;
+
+        if (now >= next_report) {
+            report(window, growth, (now - start) / 1e9);
+            scan_names();
+            next_report += 1000000000ull;
+        }
+        if (seconds > 0 && now - start >= (uint64_t)(seconds * 1e9))
+            break;
+
+        /* Absolute deadlines, so the sampling rate does not drift */
+        due.tv_nsec += (long)(period % 1000000000u);
+        due.tv_sec += (time_t)(period / 1000000000u) + due.tv_nsec / 1000000000L;
+        due.tv_nsec %= 1000000000L;
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &due, NULL);
+    }
+
+    double elapsed = (mono_ns() - start) / 1e9;
+    uint64_t reads = 0, parses = 0, full = 0;
+    for (int i = 0; i < nwatch; i++) {
+        reads += watches[i]->reads;
+        parses += watches[i]->parses;
+        full += watches[i]->full_reads;
+    }
+    printf("\n%llu sampling rounds in %.1f s (%.0f/s): %llu reads, %llu full reads, %llu parsed\n",
+           (unsigned long long)samples, elapsed, samples / elapsed, (unsigned long long)reads,
+           (unsigned long long)full, (unsigned long long)parses);
+
+    if (csv != NULL && write_series(csv) == 0)
+        printf("Time series written to %s\n", csv);
+    for (int i = 0; i < nwatch; i++) {
+        if (watches[i]->fd >= 0)
+            close(watches[i]->fd);
+        free(watches[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,195 @@
+/**
+ * @file        : sigrt.c
+ * @brief       : Generic signal handler, event queue and (signal, opcode) dispatch table.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE /* MAP_ANONYMOUS */
+#include "sigrt.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "latency_hist.h"
+#include "sig_metrics.h"
+
+/* Alternate signal stack size for fault handlers */
+#define SIGRT_ALTSTACK_SIZE (64 * 1024)
+
+/** One table entry */
+struct sigrt_slot
+{
+    sigrt_fn fn;
+    void *state;
+    int specific;   /* registered for this opcode, not filled in by SIGRT_ANY_OP */
+};
+
+static struct sigrt_slot table[SIGRT_SIGNALS][SIGRT_OPS];
+static sigset_t registered;
+
+/* Handler -> main loop queue; dispatching happens outside signal context */
+static struct event_queue events;
+static struct sig_trace *volatile trace;
+static uint64_t unhandled;
+
+/* The only handler: record, queue, count; everything else waits for sigrt_dispatch() */
+static void sigrt_handler(int signum, siginfo_t *info, void *context)
+{
+    (void)context;
+    uint64_t start = mono_ns();
+    struct sig_trace *t = trace;
+    if (t != NULL)
+        st_record(t, signum, info);
+    if (eq_push(&events, signum, info) == -1)
+        sm_dropped(signum);
+    sm_handled(signum, start);
+}
+
+int sigrt_init(const char *program)
+{
+    memset(table, 0, sizeof(table));
+    sigemptyset(&registered);
+    eq_init(&events);
+    if (program != NULL)
+        return sm_open(program);
+    return 0;
+}
+
+void sigrt_trace(struct sig_trace *t)
+{
+    trace = t;
+}
+
+int sigrt_on(int signo, int op, sigrt_fn fn, void *state)
+{
+    if (signo <= 0 || signo >= SIGRT_SIGNALS || op < SIGRT_ANY_OP || op >= SIGRT_OPS)
+        return -1;
+
+    if (op == SIGRT_ANY_OP) {
+        for (int o = 0; o < SIGRT_OPS; o++) {
+            if (!table[signo][o].specific) {
+                table[signo][o].fn = fn;
+                table[signo][o].state = state;
+            }
+        }
+    } else {
+        table[signo][op].fn = fn;
+        table[signo][op].state = state;
+        table[signo][op].specific = 1;
+    }
+    sigaddset(&registered, signo);
+    return 0;
+}
+
+int sigrt_start(sigset_t *waitmask)
+{
+    /* Blocked before the handlers exist, so nothing arrives half set up */
+    if (waitmask != NULL && sigprocmask(SIG_BLOCK, &registered, waitmask) == -1) {
+        perror("sigprocmask");
+        return -1;
+    }
+
+    for (int signo = 1; signo < SIGRT_SIGNALS; signo++) {
+        if (sigismember(&registered, signo) != 1)
+            continue;
+        if (sigrt_action(signo, sigrt_handler, &registered) == -1)
+            return -1;
+    }
+    return 0;
+}
+
+int sigrt_dispatch(void)
+{
+    struct sig_event ev;
+    int n = 0;
+    while (eq_pop(&events, &ev)) {
+        struct payload p;
+        payload_decode(payload_raw(ev.value), &p);
+        const struct sigrt_slot *slot = &table[ev.signo][p.op];
+        if (slot->fn != NULL)
+            slot->fn(&ev, &p, slot->state);
+        else
+            unhandled++;
+        n++;
+    }
+    return n;
+}
+
+int sigrt_action(int signo, void (*handler)(int, siginfo_t *, void *), const sigset_t *mask)
+{
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_sigaction = handler;
+    sa.sa_flags = SA_SIGINFO;
+    if (mask != NULL)
+        sa.sa_mask = *mask;
+    else
+        sigemptyset(&sa.sa_mask);
+    if (sigaction(signo, &sa, NULL) == -1) {
+        perror("sigaction");
+        return -1;
+    }
+    return 0;
+}
+
+int sigrt_fault_action(int signo, void (*handler)(int, siginfo_t *, void *),
+                       struct sigaction *previous)
+{
+    /* Reuse an alternate stack that is already set up */
+    stack_t ss;
+    if (sigaltstack(NULL, &ss) == -1 || (ss.ss_flags & SS_DISABLE)) {
+        ss.ss_sp = mmap(NULL, SIGRT_ALTSTACK_SIZE, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ss.ss_sp == MAP_FAILED) {
+            perror("mmap");
+            return -1;
+        }
+        ss.ss_size = SIGRT_ALTSTACK_SIZE;
+        ss.ss_flags = 0;
+        if (sigaltstack(&ss, NULL) == -1) {
+            perror("sigaltstack");
+            munmap(ss.ss_sp, SIGRT_ALTSTACK_SIZE);
+            return -1;
+        }
+    }
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_sigaction = handler;
+    sa.sa_flags = SA_SIGINFO | SA_ONSTACK;
+    sigemptyset(&sa.sa_mask);
+    if (sigaction(signo, &sa, previous) == -1) {
+        perror("sigaction");
+        return -1;
+    }
+    return 0;
+}
+
+void sigrt_chain(int signo, const struct sigaction *previous, siginfo_t *info, void *context)
+{
+    if ((previous->sa_flags & SA_SIGINFO) && previous->sa_sigaction != NULL) {
+        previous->sa_sigaction(signo, info, context);
+    } else if (previous->sa_handler != SIG_DFL && previous->sa_handler != SIG_IGN) {
+        previous->sa_handler(signo);
+    } else {
+        /* Default action: reinstall it; the faulting access repeats and gets it */
+        sigaction(signo, previous, NULL);
+    }
+}
+
+uint64_t sigrt_dropped(void)
+{
+    return eq_dropped(&events);
+}
+
+uint64_t sigrt_unhandled(void)
+{
+    return unhandled;
+}
@@ -0,0 +1,122 @@
+/**
+ * @file        : sigrt.h
+ * @brief       : Shared signal runtime: one init call, one generic handler, O(1) opcode dispatch.
+ *
+ * Details      :
+ * - Every program used to declare its own handlers, each doing the same
+ *   three things (record to the trace, push onto the event queue, count in
+ *   the metrics page) behind its own memset()/sigaction() block. sigrt owns
+ *   that: one SA_SIGINFO handler for every registered signal, one event
+ *   queue, the trace and the metrics page.
+ * - Handlers are registered once, each with its preallocated state, in a
+ *   table indexed by [signal number][payload opcode] (payload.h). A message
+ *   decodes to its opcode (0 for a plain sival_int), so dispatch is two
+ *   array indexes and an indirect call whatever the number of handlers;
+ *   a new message type is a new sigrt_on() line, not new handler code.
+ * - Registering SIGRT_ANY_OP fills every opcode slot of that signal that
+ *   has no handler of its own, in either order of registration.
+ * - The table is consulted by sigrt_dispatch() in the main loop, never in
+ *   signal context, so handlers may print, sleep and send. The time spent
+ *   in signal context is what the metrics page reports per signal.
+ * - libsigrt.a bundles this with every shared module (event queue,
+ *   payload, channels, metrics, trace, peers, flow control, ...); all the
+ *   programs link against it.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#ifndef SIGRT_H
+#define SIGRT_H
+
+#include <signal.h>
+#include <stdint.h>
+
+#include "event_queue.h"
+#include "payload.h"
+#include "sig_trace.h"
+
+/* Signal numbers 1..64 index the table directly */
+#define SIGRT_SIGNALS 65
+
+/* One slot per opcode the payload can carry */
+#define SIGRT_OPS ((int)PAYLOAD_OP_MASK + 1)
+
+/* sigrt_on() opcode meaning "every opcode without a handler of its own" */
+#define SIGRT_ANY_OP (-1)
+
+/**
+ * A registered handler; runs from sigrt_dispatch() in the main loop.
+ * @p p is the decoded payload (op PAYLOAD_OP_NONE and seq = sival_int for
+ * a plain value), @p state what was passed to sigrt_on().
+ */
+typedef void (*sigrt_fn)(const struct sig_event *ev, const struct payload *p, void *state);
+
+/**
+ * @brief Set up the event queue and, when @p program is not NULL, the
+ *        metrics page (sig_metrics.h) under that name. Call first.
+ * @return 0 on success, -1 on failure (message printed).
+ */
+int sigrt_init(const char *program);
+
+/** @brief Also append every signal to @p trace (sig_trace.h); NULL stops tracing. */
+void sigrt_trace(struct sig_trace *trace);
+
+/**
+ * @brief Register @p fn with @p state for @p signo carrying opcode @p op
+ *        (or SIGRT_ANY_OP). A later registration of the same slot replaces it.
+ * @return 0 on success, -1 if @p signo or @p op is out of range.
+ */
+int sigrt_on(int signo, int op, sigrt_fn fn, void *state);
+
+/**
+ * @brief Install the generic handler for every registered signal. While
+ *        one runs all registered signals are blocked, so a burst cannot
+ *        nest handlers. With @p waitmask the registered signals are also
+ *        blocked and the previous mask is stored there, for sigsuspend()
+ *        or epoll_pwait(); with NULL they stay deliverable at any time.
+ * @return 0 on success, -1 on failure (message printed).
+ */
+int sigrt_start(sigset_t *waitmask);
+
+/**
+ * @brief Run the handler of every queued signal, oldest first.
+ * @return Number of signals dispatched (including unhandled ones).
+ */
+int sigrt_dispatch(void);
+
+/**
+ * @brief sigaction() boilerplate for a handler that must run in signal
+ *        context (e.g. one that siglongjmp()s): SA_SIGINFO, @p mask
+ *        blocked while it runs (NULL: none).
+ * @return 0 on success, -1 on failure (message printed).
+ */
+int sigrt_action(int signo, void (*handler)(int, siginfo_t *, void *), const sigset_t *mask);
+
+/**
+ * @brief Install @p handler for a synchronous fault signal (SIGSEGV, SIGBUS)
+ *        on an alternate stack, so it runs even when the fault came from a
+ *        blown stack. The stack is set up on first use and shared by every
+ *        caller. The replaced action is stored in @p previous for sigrt_chain().
+ * @return 0 on success, -1 on failure (message printed).
+ */
+int sigrt_fault_action(int signo, void (*handler)(int, siginfo_t *, void *),
+                       struct sigaction *previous);
+
+/**
+ * @brief Hand a fault that is not ours to @p previous, the action
+ *        sigrt_fault_action() replaced. If that was the default action it is
+ *        reinstalled: the faulting access repeats and gets it. Signal-safe.
+ */
+void sigrt_chain(int signo, const struct sigaction *previous, siginfo_t *info, void *context);
+
+/** @brief Signals lost because the event queue was full. */
+uint64_t sigrt_dropped(void);
+
+/** @brief Signals dispatched whose (signal, opcode) slot had no handler. */
+uint64_t sigrt_unhandled(void);
+
+#endif /* SIGRT_H */
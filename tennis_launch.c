@@ -0,0 +1,209 @@
+/**
+ * @file        : tennis_launch.c
+ * @brief       : One-command "Signal Tennis" launcher — starts both players and times the setup.
+ *
+ * Details      :
+ * - Spawns recv_tennis and serve_tennis (from the launcher's own directory)
+ *   with a fresh rendezvous name per rally, so the players find each other
+ *   through rendezvous.c and nobody has to copy a PID.
+ * - Players are started with posix_spawn(), which avoids copying the
+ *   launcher's page tables the way fork() + exec() would.
+ * - The server reports when it served (-S fd) over a pipe, giving the setup
+ *   time from spawning the first player to the first volley; the rest of
+ *   the game is timed until both players have exited.
+ * - -c runs many rallies back to back for benchmark sweeps; any rally whose
+ *   players fail is counted and makes the exit status non-zero.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Extra Credit – Signal Tennis
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ *
+ * Compile      : make tennis_launch
+ * Usage        : ./tennis_launch [-f] [-q] [-n volleys] [-c rallies]
+ * Example      : ./tennis_launch -f -q -n 10 -c 1000
+ *
+ * Algorithm
+ *  1. Find recv_tennis and serve_tennis next to /proc/self/exe.
+ *  2. For each rally: create the report pipe, note the time, spawn the
+ *     receiver and then the server with the same rendezvous name.
+ *  3. Read the serve time from the pipe (setup), reap both players (game).
+ *  4. Print setup and game percentiles and rallies per second.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <spawn.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "latency_hist.h"
+
+#define DEFAULT_VOLLEYS 10
+#define DEFAULT_RALLIES 1
+
+extern char **environ;
+
+static char recv_path[PATH_MAX];
+static char serve_path[PATH_MAX];
+
+/* Players live next to the launcher, wherever it was started from */
+static int find_players(void)
+{
+    char self[PATH_MAX - 16]; /* room for the player names */
+    ssize_t n = readlink("/proc/self/exe", self, sizeof(self) - 1);
+    if (n <= 0) {
+        perror("readlink /proc/self/exe");
+        return -1;
+    }
+    self[n] = '\0';
+    char *slash = strrchr(self, '/');
+    *slash = '\0';
+    snprintf(recv_path, sizeof(recv_path), "%s/recv_tennis", self);
+    snprintf(serve_path, sizeof(serve_path), "%s/serve_tennis", self);
+    if (access(recv_path, X_OK) == -1 || access(serve_path, X_OK) == -1) {
+        fprintf(stderr, "[LAUNCH] build recv_tennis and serve_tennis first (make)\n");
+        return -1;
+    }
+    return 0;
+}
+
+/* Spawn one player; stdout goes to /dev/null when @p quiet, @p close_fd is closed in the child */
+static pid_t spawn_player(const char *path, char *const args[], int quiet, int close_fd)
+{
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    if (quiet)
+        posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+    if (close_fd >= 0)
+        posix_spawn_file_actions_addclose(&actions, close_fd);
+
+    pid_t pid;
+    int rc = posix_spawn(&pid, path, &actions, NULL, args, environ);
+    posix_spawn_file_actions_destroy(&actions);
+    if (rc != 0) {
+        errno = rc;
+        perror(path);
+        return -1;
+    }
+    return pid;
+}
+
+/* One rally; returns 0 when both players finished the game */
+static int run_rally(int index, int fast, int quiet, const char *volleys,
+                     struct latency_hist *setup, struct latency_hist *game)
+{
+    char court[64], fd_arg[16];
+    snprintf(court, sizeof(court), "launch.%d.%d", (int)getpid(), index);
+
+    int report[2];
+    if (pipe(report) == -1) {
+        perror("pipe");
+        return -1;
+    }
+    /* Only the server may hold the write end, or EOF would never come */
+    fcntl(report[0], F_SETFD, FD_CLOEXEC);
+    snprintf(fd_arg, sizeof(fd_arg), "%d", report[1]);
+
+    char *recv_args[] = { "recv_tennis", "-r", court, "-n", (char *)volleys,
+                          fast ? "-f" : NULL, NULL };
+    char *serve_args[] = { "serve_tennis", "-r", court, "-n", (char *)volleys, "-S", fd_arg,
+                           fast ? "-f" : NULL, NULL };
+
+    uint64_t t0 = mono_ns();
+    pid_t receiver = spawn_player(recv_path, recv_args, quiet, report[1]);
+    pid_t server = receiver == -1 ? -1 : spawn_player(serve_path, serve_args, quiet, -1);
+    close(report[1]);
+
+    /* EOF instead of a time means the server never served */
+    uint64_t served = 0;
+    ssize_t n = server == -1 ? 0 : read(report[0], &served, sizeof(served));
+    close(report[0]);
+
+    int ok = n == (ssize_t)sizeof(served);
+    pid_t players[2] = { receiver, server };
+    for (int i = 0; i < 2; i++) {
+        int status;
+        if (players[i] == -1)
+            continue;
+        if (!ok)
+            kill(players[i], SIGTERM); /* do not leave the other one waiting */
+        if (waitpid(players[i], &status, 0) == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+            ok = 0;
+    }
+    uint64_t done = mono_ns();
+
+    if (!ok)
+        return -1;
+    hist_record(setup, served - t0);
+    hist_record(game, done - served);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    int fast = 0, quiet = 0;
+    int volleys = DEFAULT_VOLLEYS;
+    long rallies = DEFAULT_RALLIES;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "fqn:c:")) != -1) {
+        switch (opt) {
+        case 'f':
+            fast = 1;
+            break;
+        case 'q':
+            quiet = 1;
+            break;
+        case 'n':
+            volleys = atoi(optarg);
+            break;
+        case 'c':
+            rallies = atol(optarg);
+            break;
+        default:
+            goto usage;
+        }
+    }
+    if (volleys < 1 || rallies < 1)
+        goto usage;
+    if (find_players() == -1)
+        return 1;
+
+    char volley_arg[16];
+    snprintf(volley_arg, sizeof(volley_arg), "%d", volleys);
+
+    printf("[LAUNCH] %ld rally(ies) of %d volleys, %s pacing\n", rallies, volleys,
+           fast ? "no" : "1-2 s");
+    fflush(stdout);
+
+    static struct latency_hist setup, game;
+    hist_init(&setup);
+    hist_init(&game);
+
+    long failed = 0;
+    uint64_t t0 = mono_ns();
+    for (long i = 0; i < rallies; i++) {
+        if (run_rally((int)i, fast, quiet, volley_arg, &setup, &game) == -1) {
+            failed++;
+            fprintf(stderr, "[LAUNCH] rally %ld failed\n", i);
+        }
+    }
+    double wall = (mono_ns() - t0) / 1e9;
+
+    printf("[LAUNCH] %ld rally(ies) ok, %ld failed in %.3f s = %.1f rallies/s\n",
+           rallies - failed, failed, wall, rallies / wall);
+    hist_print(&setup, "[LAUNCH] setup (spawn -> first volley)", stdout);
+    hist_print(&game, "[LAUNCH] game  (first volley -> both exited)", stdout);
+    return failed == 0 ? 0 : 1;
+
+usage:
+    fprintf(stderr, "Usage: %s [-f] [-q] [-n volleys(>=1)] [-c rallies(>=1)]\n", argv[0]);
+    return 1;
+}
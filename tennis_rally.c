@@ -0,0 +1,238 @@
+/**
+ * @file        : tennis_rally.c
+ * @brief       : Unpaced "Signal Tennis" rally used for latency benchmarking.
+ *
+ * Details      :
+ * - The server stamps CLOCK_MONOTONIC right before each sigqueue() and
+ *   again when the ball comes back; the difference is one round trip.
+ * - Whoever receives the final volley sends SIGUSR2 so the other player
+ *   stops waiting, exactly like play_ball() in the interactive game.
+ * - The wait mode is process-wide state set before the rally (and
+ *   inherited by fork()); the signalfd for RALLY_WAIT_FD_SPIN is created on
+ *   first use, in the process that reads it.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Extra Credit – Signal Tennis
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "tennis_rally.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/signalfd.h>
+
+#include "cpu_affinity.h"
+
+static const char *wait_names[RALLY_WAIT_MODES] = { "block", "spin", "fd-spin" };
+
+static enum rally_wait wait_mode = RALLY_WAIT_BLOCK;
+static uint64_t spin_budget = RALLY_DEFAULT_SPIN_NS;
+static int ball_fd = -1;    /* signalfd for RALLY_WAIT_FD_SPIN, opened lazily */
+
+/* The set of signals a player waits on: the ball and game over */
+static void rally_mask(sigset_t *set)
+{
+    sigemptyset(set);
+    sigaddset(set, SIGUSR1);
+    sigaddset(set, SIGUSR2);
+}
+
+/* Poll with a zero timeout for the spin budget, then sleep in sigwaitinfo() */
+static int spin_wait(const sigset_t *set, siginfo_t *info)
+{
+    static const struct timespec zero = { 0, 0 };
+    uint64_t start = mono_ns();
+
+    do {
+        int sig = sigtimedwait(set, info, &zero);
+        if (sig > 0)
+            return sig;
+        if (errno != EAGAIN && errno != EINTR)
+            return -1;
+    } while (mono_ns() - start < spin_budget);
+    return sigwaitinfo(set, info);
+}
+
+/* Read the non-blocking signalfd for the spin budget, then sleep in poll() */
+static int fd_spin_wait(const sigset_t *set, siginfo_t *info)
+{
+    if (ball_fd < 0) {
+        ball_fd = signalfd(-1, set, SFD_NONBLOCK | SFD_CLOEXEC);
+        if (ball_fd == -1)
+            return -1;
+    }
+
+    uint64_t start = mono_ns();
+    for (;;) {
+        struct signalfd_siginfo fdsi;
+        ssize_t n = read(ball_fd, &fdsi, sizeof(fdsi));
+        if (n == (ssize_t)sizeof(fdsi)) {
+            memset(info, 0, sizeof(*info));
+            info->si_pid = (pid_t)fdsi.ssi_pid;
+            info->si_value.sival_int = fdsi.ssi_int;
+            return (int)fdsi.ssi_signo;
+        }
+        if (n == -1 && errno != EAGAIN && errno != EINTR)
+            return -1;
+        if (mono_ns() - start >= spin_budget) {
+            struct pollfd pfd = { ball_fd, POLLIN, 0 };
+            if (poll(&pfd, 1, -1) == -1 && errno != EINTR)
+                return -1;
+        }
+    }
+}
+
+/* Wait for the next ball; returns its volley count, 0 on game over, -1 on error */
+static long wait_ball(const sigset_t *set, pid_t *from)
+{
+    siginfo_t info;
+    int sig;
+
+    do {
+        if (wait_mode == RALLY_WAIT_SPIN)
+            sig = spin_wait(set, &info);
+        else if (wait_mode == RALLY_WAIT_FD_SPIN)
+            sig = fd_spin_wait(set, &info);
+        else
+            sig = sigwaitinfo(set, &info);
+    } while (sig == -1 && errno == EINTR);
+
+    if (sig == -1) {
+        perror(wait_mode == RALLY_WAIT_FD_SPIN ? "signalfd" : "sigwaitinfo");
+        return -1;
+    }
+    if (sig == SIGUSR2)
+        return 0;
+
+    if (from != NULL)
+        *from = info.si_pid;
+    return info.si_value.sival_int;
+}
+
+/* Hit the ball to the opponent; retried while the kernel queue is full */
+static int hit(pid_t opponent, long volley)
+{
+    union sigval sv;
+    sv.sival_int = (int)volley;
+
+    while (sigqueue(opponent, SIGUSR1, sv) == -1) {
+        if (errno != EAGAIN) {
+            perror("sigqueue");
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int rally_block_signals(void)
+{
+    sigset_t set;
+    rally_mask(&set);
+    if (sigprocmask(SIG_BLOCK, &set, NULL) == -1) {
+        perror("sigprocmask");
+        return -1;
+    }
+    return 0;
+}
+
+void rally_set_wait(enum rally_wait mode, uint64_t spin_ns)
+{
+    wait_mode = mode;
+    spin_budget = spin_ns;
+    if (ball_fd >= 0 && mode != RALLY_WAIT_FD_SPIN) {
+        close(ball_fd);
+        ball_fd = -1;
+    }
+}
+
+const char *rally_wait_name(enum rally_wait mode)
+{
+    return mode >= 0 && mode < RALLY_WAIT_MODES ? wait_names[mode] : "?";
+}
+
+int rally_realtime(int cpu, int fifo_priority, int lock_memory)
+{
+    int rc = 0;
+
+    if (cpu >= 0 && pin_process_to_cpu(0, cpu) == -1)
+        rc = -1;
+    if (fifo_priority > 0) {
+        struct sched_param sp = { .sched_priority = fifo_priority };
+        if (sched_setscheduler(0, SCHED_FIFO, &sp) == -1) {
+            perror("sched_setscheduler(SCHED_FIFO)");
+            rc = -1;
+        }
+    }
+    /* No page faults in the rally loop: everything mapped now and later stays resident */
+    if (lock_memory && mlockall(MCL_CURRENT | MCL_FUTURE) == -1) {
+        perror("mlockall");
+        rc = -1;
+    }
+    return rc;
+}
+
+long rally_serve(pid_t opponent, long volleys, struct latency_hist *rtt)
+{
+    sigset_t set;
+    rally_mask(&set);
+
+    long volley = 1;
+    while (1) {
+        uint64_t sent = mono_ns();
+        if (hit(opponent, volley) == -1)
+            return -1;
+        if (volley >= volleys) {
+            /* The opponent receives the last ball and calls it; take that
+               SIGUSR2 now, or it stays pending and ends our next rally */
+            long end = wait_ball(&set, NULL);
+            return end < 0 ? -1 : volley;
+        }
+
+        long back = wait_ball(&set, NULL);
+        if (back <= 0)
+            return back == 0 ? volley : -1;
+        if (rtt != NULL)
+            hist_record(rtt, mono_ns() - sent);
+
+        if (back >= volleys) {
+            kill(opponent, SIGUSR2);
+            return back;
+        }
+        volley = back + 1;
+    }
+}
+
+long rally_return(long volleys)
+{
+    sigset_t set;
+    rally_mask(&set);
+
+    pid_t opponent = 0;
+    while (1) {
+        long volley = wait_ball(&set, &opponent);
+        if (volley <= 0)
+            return volley;
+
+        if (volley >= volleys) {
+            kill(opponent, SIGUSR2);
+            return volley;
+        }
+        if (hit(opponent, volley + 1) == -1)
+            return -1;
+        if (volley + 1 >= volleys) {
+            /* Our hit was the last one; wait for the server to call it */
+            long end = wait_ball(&set, NULL);
+            return end < 0 ? -1 : volley + 1;
+        }
+    }
+}
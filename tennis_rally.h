@@ -0,0 +1,88 @@
+/**
+ * @file        : tennis_rally.h
+ * @brief       : Unpaced "Signal Tennis" rally used for latency benchmarking.
+ *
+ * Details      :
+ * - Same protocol as serve_tennis/recv_tennis: SIGUSR1 carries the volley
+ *   count in sival_int, SIGUSR2 tells the opponent the game is over.
+ * - No sleeps, no beeps and no handlers: both players block SIGUSR1/SIGUSR2
+ *   and wait for the ball with sigwaitinfo(), so each volley costs exactly
+ *   one sigqueue() and one wakeup.
+ * - Opt-in low-latency waits skip even that wakeup by busy-polling: a
+ *   zero-timeout sigtimedwait() loop, or a non-blocking signalfd read()
+ *   loop. Both spin for a budget and then fall back to blocking, so an idle
+ *   player does not burn a CPU forever. rally_realtime() adds SCHED_FIFO,
+ *   mlockall() and CPU pinning. Spinning only pays off when the two players
+ *   sit on different CPUs; sharing one, each spin delays the opponent.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Extra Credit – Signal Tennis
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#ifndef TENNIS_RALLY_H
+#define TENNIS_RALLY_H
+
+#include <stdint.h>
+#include <sys/types.h>
+#include "latency_hist.h"
+
+/* Default spin before a polling wait blocks */
+#define RALLY_DEFAULT_SPIN_NS 1000000ULL
+
+/** How a player waits for the next ball */
+enum rally_wait
+{
+    RALLY_WAIT_BLOCK,   /* sigwaitinfo(): sleep until the ball arrives */
+    RALLY_WAIT_SPIN,    /* sigtimedwait() with a zero timeout, then block */
+    RALLY_WAIT_FD_SPIN, /* non-blocking signalfd read(), then poll() */
+    RALLY_WAIT_MODES
+};
+
+/**
+ * @brief Block SIGUSR1/SIGUSR2 in the calling thread.
+ *        Call before fork() so neither player can miss the serve.
+ * @return 0 on success, -1 on failure.
+ */
+int rally_block_signals(void);
+
+/**
+ * @brief Choose how this process waits for balls from now on (inherited
+ *        across fork()); polling modes spin for @p spin_ns before blocking.
+ */
+void rally_set_wait(enum rally_wait mode, uint64_t spin_ns);
+
+/** @brief Short name of @p mode ("block", "spin", "fd-spin"). */
+const char *rally_wait_name(enum rally_wait mode);
+
+/**
+ * @brief Low-latency setup for the calling process: pin it to @p cpu
+ *        (-1 = leave), run it SCHED_FIFO at @p fifo_priority (0 = leave) and
+ *        lock its memory when @p lock_memory is set.
+ * @return 0 on success, -1 if any step failed (message printed; the rest
+ *         are still applied).
+ */
+int rally_realtime(int cpu, int fifo_priority, int lock_memory);
+
+/**
+ * @brief Serve to @p opponent and rally until @p volleys hits have been made.
+ *
+ * @param opponent PID of the returning player.
+ * @param volleys  Total number of volleys (hits by both players).
+ * @param rtt      Histogram receiving one round-trip time per returned ball
+ *                 (may be NULL).
+ * @return Number of volleys completed, or -1 on error.
+ */
+long rally_serve(pid_t opponent, long volleys, struct latency_hist *rtt);
+
+/**
+ * @brief Wait for a serve and return every ball until the game is over.
+ *
+ * @param volleys Total number of volleys for the game.
+ * @return Number of volleys seen, or -1 on error.
+ */
+long rally_return(long volleys);
+
+#endif /* TENNIS_RALLY_H */
@@ -0,0 +1,217 @@
+/**
+ * @file        : tennis_tournament.c
+ * @brief       : "Signal Tennis" tournament — N concurrent unpaced rallies with aggregate stats.
+ *
+ * Details      :
+ * - Forks N server/receiver pairs; the driver knows both PIDs, so nothing
+ *   has to be pasted by hand.
+ * - Placement: "spread" pins each player of each pair to its own CPU
+ *   (round-robin over the online CPUs), "packed" puts every player on CPU 0,
+ *   "none" leaves scheduling to the kernel.
+ * - All rallies start together when the driver closes a start pipe.
+ * - Each server writes its volley count, elapsed time and RTT histogram into
+ *   a MAP_SHARED results table; the driver prints per-pair and total
+ *   volleys/s plus merged RTT percentiles.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Extra Credit – Signal Tennis
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ *
+ * Compile      : make tennis_tournament
+ * Usage        : ./tennis_tournament [-p pairs] [-n volleys] [-m spread|packed|none]
+ * Example      : ./tennis_tournament -p 8 -n 200000 -m spread
+ *
+ * Algorithm
+ *  1. Map the shared results table and create the start pipe.
+ *  2. Block SIGUSR1/SIGUSR2, then fork each receiver and its server.
+ *  3. Every player pins itself; servers block reading the start pipe.
+ *  4. Close the pipe to start all rallies at once; reap every player.
+ *  5. Merge the histograms and print the table.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE /* MAP_ANONYMOUS */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#include "latency_hist.h"
+#include "tennis_rally.h"
+#include "cpu_affinity.h"
+
+#define DEFAULT_PAIRS   2
+#define DEFAULT_VOLLEYS 100000L
+#define MAX_PAIRS       512
+
+enum placement { PLACE_NONE, PLACE_SPREAD, PLACE_PACKED };
+
+/** One pair's result, written by its server process */
+struct pair_result
+{
+    pid_t server;
+    pid_t receiver;
+    long volleys;
+    uint64_t elapsed_ns;
+    int ok;
+    struct latency_hist rtt;
+};
+
+/* Pin a player according to the placement policy; slot is 0..2*pairs-1 */
+static void place(enum placement mode, int slot)
+{
+    if (mode == PLACE_SPREAD)
+        pin_process_to_cpu(0, slot);
+    else if (mode == PLACE_PACKED)
+        pin_process_to_cpu(0, 0);
+}
+
+int main(int argc, char *argv[])
+{
+    int pairs = DEFAULT_PAIRS;
+    long volleys = DEFAULT_VOLLEYS;
+    enum placement mode = PLACE_SPREAD;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "p:n:m:")) != -1) {
+        switch (opt) {
+        case 'p':
+            pairs = atoi(optarg);
+            break;
+        case 'n':
+            volleys = atol(optarg);
+            break;
+        case 'm':
+            if (strcmp(optarg, "spread") == 0)
+                mode = PLACE_SPREAD;
+            else if (strcmp(optarg, "packed") == 0)
+                mode = PLACE_PACKED;
+            else if (strcmp(optarg, "none") == 0)
+                mode = PLACE_NONE;
+            else
+                goto usage;
+            break;
+        default:
+            goto usage;
+        }
+    }
+    if (pairs < 1 || pairs > MAX_PAIRS || volleys < 2)
+        goto usage;
+
+    struct pair_result *results = mmap(NULL, sizeof(*results) * (size_t)pairs,
+                                       PROT_READ | PROT_WRITE,
+                                       MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (results == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+
+    int start_pipe[2];
+    if (pipe(start_pipe) == -1) {
+        perror("pipe");
+        return 1;
+    }
+
+    /* Inherited by every player, so no serve can arrive unblocked */
+    if (rally_block_signals() == -1)
+        return 1;
+
+    printf("[TOURNAMENT] %d pair(s), %ld volleys each, placement %s, %d CPU(s)\n",
+           pairs, volleys,
+           mode == PLACE_SPREAD ? "spread" : mode == PLACE_PACKED ? "packed" : "none",
+           online_cpus());
+    fflush(stdout);
+
+    int forked = 0;
+    for (int i = 0; i < pairs; i++) {
+        struct pair_result *r = &results[i];
+        hist_init(&r->rtt);
+
+        pid_t receiver = fork();
+        if (receiver == -1) {
+            perror("fork");
+            break;
+        }
+        if (receiver == 0) {
+            close(start_pipe[1]);
+            place(mode, 2 * i + 1);
+            _exit(rally_return(volleys) < 0 ? 1 : 0);
+        }
+
+        pid_t server = fork();
+        if (server == -1) {
+            perror("fork");
+            kill(receiver, SIGUSR2);
+            break;
+        }
+        if (server == 0) {
+            close(start_pipe[1]);
+            place(mode, 2 * i);
+
+            /* Returns 0 (EOF) once the driver closes its end */
+            char go;
+            while (read(start_pipe[0], &go, 1) > 0)
+                ;
+
+            uint64_t t0 = mono_ns();
+            long done = rally_serve(receiver, volleys, &r->rtt);
+            r->elapsed_ns = mono_ns() - t0;
+            r->volleys = done;
+            r->ok = done >= volleys;
+            _exit(r->ok ? 0 : 1);
+        }
+
+        r->server = server;
+        r->receiver = receiver;
+        forked++;
+    }
+
+    /* Start every rally at once */
+    close(start_pipe[0]);
+    uint64_t t0 = mono_ns();
+    close(start_pipe[1]);
+
+    int status;
+    while (wait(&status) > 0)
+        ;
+    double wall = (mono_ns() - t0) / 1e9;
+
+    static struct latency_hist all;
+    hist_init(&all);
+    long total = 0;
+    int failed = 0;
+
+    printf("%-5s %8s %8s %10s %12s %10s %10s %10s\n",
+           "pair", "server", "recv", "volleys", "volleys/s", "p50(us)", "p99(us)", "max(us)");
+    for (int i = 0; i < forked; i++) {
+        struct pair_result *r = &results[i];
+        double secs = r->elapsed_ns / 1e9;
+        if (!r->ok)
+            failed++;
+        printf("%-5d %8d %8d %10ld %12.0f %10.2f %10.2f %10.2f%s\n",
+               i, r->server, r->receiver, r->volleys,
+               secs > 0 ? r->volleys / secs : 0.0,
+               hist_percentile(&r->rtt, 50.0) / 1e3,
+               hist_percentile(&r->rtt, 99.0) / 1e3,
+               r->rtt.count ? r->rtt.max / 1e3 : 0.0,
+               r->ok ? "" : "  (aborted)");
+        total += r->volleys > 0 ? r->volleys : 0;
+        hist_merge(&all, &r->rtt);
+    }
+
+    printf("[TOURNAMENT] total %ld volleys in %.3f s = %.0f volleys/s\n",
+           total, wall, total / wall);
+    hist_print(&all, "[TOURNAMENT] RTT", stdout);
+
+    munmap(results, sizeof(*results) * (size_t)pairs);
+    return failed == 0 && forked == pairs ? 0 : 1;
+
+usage:
+    fprintf(stderr, "Usage: %s [-p pairs(1-%d)] [-n volleys(>=2)] [-m spread|packed|none]\n",
+            argv[0], MAX_PAIRS);
+    return 1;
+}
@@ -0,0 +1,241 @@
+/**
+ * @file        : timer_wheel.c
+ * @brief       : Hierarchical timing wheel driven by a single POSIX interval timer.
+ *
+ * Details      :
+ * - Placement follows the classic Linux timer wheel: a timer whose distance
+ *   from "now" fits in 8*(L+1) bits goes to level L, slot (expires >> 8L) & 255.
+ * - Every time level 0 wraps, the next slot of level 1 is emptied and its
+ *   timers re-added (landing in level 0); level 1 wrapping cascades level 2,
+ *   and so on.
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "timer_wheel.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Farthest a timer may be scheduled ahead (anything later is clamped) */
+#define TW_MAX_DELTA ((1ull << (TW_LEVELS * TW_SLOT_BITS)) - 1)
+
+static uint64_t clock_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void list_init(struct tw_timer *head)
+{
+    head->next = head;
+    head->prev = head;
+}
+
+static void list_append(struct tw_timer *head, struct tw_timer *t)
+{
+    t->prev = head->prev;
+    t->next = head;
+    head->prev->next = t;
+    head->prev = t;
+}
+
+static void list_unlink(struct tw_timer *t)
+{
+    t->prev->next = t->next;
+    t->next->prev = t->prev;
+    t->next = NULL;
+    t->prev = NULL;
+}
+
+/* Put an armed timer into the slot matching its distance from now */
+static void place(struct timer_wheel *w, struct tw_timer *t)
+{
+    uint64_t expires = t->expires;
+    struct tw_timer *head;
+
+    if (expires < w->now) {
+        head = &w->slots[0][w->now & TW_SLOT_MASK];   /* overdue: next tick */
+    } else {
+        uint64_t delta = expires - w->now;
+        if (delta > TW_MAX_DELTA) {
+            delta = TW_MAX_DELTA;
+            expires = w->now + delta;
+            t->expires = expires;
+        }
+        int level = 0;
+        while (level < TW_LEVELS - 1 && delta >= (1ull << (TW_SLOT_BITS * (level + 1))))
+            level++;
+        head = &w->slots[level][(expires >> (TW_SLOT_BITS * level)) & TW_SLOT_MASK];
+    }
+    list_append(head, t);
+}
+
+/* Move every timer of one upper-level slot down; returns that slot's index */
+static unsigned cascade(struct timer_wheel *w, int level)
+{
+    unsigned index = (unsigned)(w->now >> (TW_SLOT_BITS * level)) & TW_SLOT_MASK;
+    struct tw_timer *head = &w->slots[level][index];
+    struct tw_timer list;
+
+    if (head->next == head)
+        return index;
+
+    /* Detach the whole slot first; place() may append to other slots */
+    list.next = head->next;
+    list.prev = head->prev;
+    list.next->prev = &list;
+    list.prev->next = &list;
+    list_init(head);
+
+    while (list.next != &list) {
+        struct tw_timer *t = list.next;
+        list_unlink(t);
+        place(w, t);
+    }
+    return index;
+}
+
+void tw_init(struct timer_wheel *w, uint64_t tick_ns)
+{
+    memset(w, 0, sizeof(*w));
+    w->tick_ns = tick_ns ? tick_ns : 1;
+    w->origin_ns = clock_now_ns();
+    for (int l = 0; l < TW_LEVELS; l++)
+        for (unsigned s = 0; s < TW_SLOTS; s++)
+            list_init(&w->slots[l][s]);
+}
+
+void tw_timer_init(struct tw_timer *t, tw_callback cb, void *arg)
+{
+    t->next = NULL;
+    t->prev = NULL;
+    t->expires = 0;
+    t->cb = cb;
+    t->arg = arg;
+}
+
+int tw_pending(const struct tw_timer *t)
+{
+    return t->next != NULL;
+}
+
+void tw_add(struct timer_wheel *w, struct tw_timer *t, uint64_t expires)
+{
+    if (tw_pending(t))
+        tw_cancel(w, t);
+    t->expires = expires;
+    place(w, t);
+    w->pending++;
+}
+
+void tw_schedule(struct timer_wheel *w, struct tw_timer *t, uint64_t delay_ns)
+{
+    /* Round up so a timer never fires early */
+    tw_add(w, t, w->now + (delay_ns + w->tick_ns - 1) / w->tick_ns);
+}
+
+int tw_cancel(struct timer_wheel *w, struct tw_timer *t)
+{
+    if (!tw_pending(t))
+        return 0;
+    list_unlink(t);
+    w->pending--;
+    return 1;
+}
+
+void tw_reschedule(struct timer_wheel *w, struct tw_timer *t, uint64_t expires)
+{
+    tw_cancel(w, t);
+    tw_add(w, t, expires);
+}
+
+size_t tw_advance(struct timer_wheel *w, uint64_t tick)
+{
+    size_t fired = 0;
+
+    while (w->now < tick) {
+        /* Nothing armed: jump straight to the target */
+        if (w->pending == 0) {
+            w->now = tick;
+            break;
+        }
+
+        unsigned index = (unsigned)(w->now & TW_SLOT_MASK);
+        if (index == 0) {
+            for (int level = 1; level < TW_LEVELS; level++)
+                if (cascade(w, level) != 0)
+                    break;
+        }
+
+        struct tw_timer *head = &w->slots[0][index];
+        w->now++;
+
+        /* Callbacks may add or cancel timers, so always take the first one */
+        while (head->next != head) {
+            struct tw_timer *t = head->next;
+            list_unlink(t);
+            w->pending--;
+            fired++;
+            if (t->cb != NULL)
+                t->cb(t, t->arg);
+        }
+    }
+    return fired;
+}
+
+uint64_t tw_clock_ticks(const struct timer_wheel *w)
+{
+    return (clock_now_ns() - w->origin_ns) / w->tick_ns;
+}
+
+size_t tw_run(struct timer_wheel *w)
+{
+    /* A timer due at tick N fires once tick N has fully started */
+    return tw_advance(w, tw_clock_ticks(w) + 1);
+}
+
+int tw_start_clock(struct timer_wheel *w, int signo)
+{
+    struct sigevent sev;
+    memset(&sev, 0, sizeof(sev));
+    sev.sigev_notify = SIGEV_SIGNAL;
+    sev.sigev_signo = signo;
+    sev.sigev_value.sival_ptr = w;
+
+    if (timer_create(CLOCK_MONOTONIC, &sev, &w->clock) == -1) {
+        perror("timer_create");
+        return -1;
+    }
+
+    /* Absolute first expiry at tick 1, so every signal lands on a tick
+       boundary measured from origin_ns, the way tw_clock_ticks() counts;
+       a relative start would run up to one tick out of phase */
+    uint64_t first = w->origin_ns + w->tick_ns;
+    struct itimerspec its;
+    its.it_interval.tv_sec = (time_t)(w->tick_ns / 1000000000ull);
+    its.it_interval.tv_nsec = (long)(w->tick_ns % 1000000000ull);
+    its.it_value.tv_sec = (time_t)(first / 1000000000ull);
+    its.it_value.tv_nsec = (long)(first % 1000000000ull);
+    if (timer_settime(w->clock, TIMER_ABSTIME, &its, NULL) == -1) {
+        perror("timer_settime");
+        timer_delete(w->clock);
+        return -1;
+    }
+    w->clock_armed = 1;
+    return 0;
+}
+
+void tw_stop_clock(struct timer_wheel *w)
+{
+    if (w->clock_armed)
+        timer_delete(w->clock);
+    w->clock_armed = 0;
+}
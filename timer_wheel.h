@@ -0,0 +1,98 @@
+/**
+ * @file        : timer_wheel.h
+ * @brief       : Hierarchical timing wheel driven by a single POSIX interval timer.
+ *
+ * Details      :
+ * - Four levels of 256 slots; level L holds timers due within 256^(L+1)
+ *   ticks. Insert and cancel are O(1) (intrusive doubly-linked lists);
+ *   timers migrate down one level when their slot's turn comes ("cascade").
+ * - One CLOCK_MONOTONIC timer_create() timer delivers a signal every tick.
+ *   The program blocks that signal, waits for it and calls tw_run(), which
+ *   fires everything due up to the current time, so missed ticks are caught up.
+ * - Replaces the one-alarm()-per-process, one-second-resolution limit with
+ *   any number of timers at the chosen tick (e.g. 100 us).
+ *
+ * Course       : CPE 2600 – Systems Programming
+ * Section      : 112
+ * Assignment   : Signals Lab
+ * Author       : rostj@msoe.edu <Jesse Rost>
+ * Date         : 10/17/26
+ */
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#define TW_LEVELS    4
+#define TW_SLOT_BITS 8
+#define TW_SLOTS     (1u << TW_SLOT_BITS)
+#define TW_SLOT_MASK (TW_SLOTS - 1)
+
+struct tw_timer;
+typedef void (*tw_callback)(struct tw_timer *timer, void *arg);
+
+/** One timer; embed it in your own struct or allocate it, the wheel never does */
+struct tw_timer
+{
+    struct tw_timer *next;
+    struct tw_timer *prev;
+    uint64_t expires;     /* absolute tick */
+    tw_callback cb;
+    void *arg;
+};
+
+struct timer_wheel
+{
+    uint64_t now;          /* ticks processed so far */
+    uint64_t tick_ns;      /* tick length */
+    uint64_t origin_ns;    /* CLOCK_MONOTONIC time of tick 0 */
+    size_t pending;        /* armed timers */
+    timer_t clock;         /* POSIX timer driving the wheel */
+    int clock_armed;
+    struct tw_timer slots[TW_LEVELS][TW_SLOTS]; /* list heads */
+};
+
+/** @brief Prepare an empty wheel with the given tick length. */
+void tw_init(struct timer_wheel *w, uint64_t tick_ns);
+
+/** @brief Prepare @p t (unarmed). */
+void tw_timer_init(struct tw_timer *t, tw_callback cb, void *arg);
+
+/** @brief Arm @p t to fire at absolute tick @p expires (past ticks fire next). */
+void tw_add(struct timer_wheel *w, struct tw_timer *t, uint64_t expires);
+
+/** @brief Arm @p t to fire @p delay_ns from the wheel's current time. */
+void tw_schedule(struct timer_wheel *w, struct tw_timer *t, uint64_t delay_ns);
+
+/** @brief Disarm @p t. Safe on a timer that is not armed. @return 1 if it was armed. */
+int tw_cancel(struct timer_wheel *w, struct tw_timer *t);
+
+/** @brief Cancel and re-arm at @p expires in one call. */
+void tw_reschedule(struct timer_wheel *w, struct tw_timer *t, uint64_t expires);
+
+/** @brief 1 if @p t is currently armed. */
+int tw_pending(const struct tw_timer *t);
+
+/** @brief Process ticks up to (not including) @p tick. @return timers fired. */
+size_t tw_advance(struct timer_wheel *w, uint64_t tick);
+
+/** @brief Tick number corresponding to the current CLOCK_MONOTONIC time. */
+uint64_t tw_clock_ticks(const struct timer_wheel *w);
+
+/** @brief Fire everything due by now. @return timers fired. */
+size_t tw_run(struct timer_wheel *w);
+
+/**
+ * @brief Start the periodic POSIX timer that delivers @p signo every tick.
+ *        Block @p signo first and wait for it (sigwaitinfo()) before tw_run().
+ * @return 0 on success, -1 on failure.
+ */
+int tw_start_clock(struct timer_wheel *w, int signo);
+
+/** @brief Delete the POSIX timer. */
+void tw_stop_clock(struct timer_wheel *w);
+
+#endif /* TIMER_WHEEL_H */